@@ -79,6 +79,30 @@
 
 #include "./bedrock_miscs.h"
 
+/* -------------------------------------------------------------------------------------------------------- */
+// --------------
+//  SIMD Support
+// --------------
+// NOTE: Vector registers are not usable in kernel space without saving the FPU state,
+//       therefore kernel builds (or _BEDROCK_NO_SIMD_) always fall back to the scalar paths.
+#if !defined(_BEDROCK_KERNEL_) && !defined(_BEDROCK_NO_SIMD_)
+#	if defined(__SSE2__)
+#		define _BEDROCK_SSE2_
+#	endif // __SSE2__
+#	if defined(__SSSE3__)
+#		define _BEDROCK_SSSE3_
+#	endif // __SSSE3__
+#	if defined(__AVX2__)
+#		define _BEDROCK_AVX2_
+#	endif // __AVX2__
+#	if defined(__PCLMUL__)
+#		define _BEDROCK_PCLMUL_
+#	endif // __PCLMUL__
+#	if defined(_BEDROCK_SSE2_)
+#		include <immintrin.h>
+#	endif // _BEDROCK_SSE2_
+#endif // SIMD_SUPPORT
+
 /* -------------------------------------------------------------------------------------------------------- */
 // ----------------
 //  Bedrock Macros
@@ -102,9 +126,33 @@
 #define CHR_TO_NUM(chr)                ((chr) - '0')
 #define TO_BOOL(var)                   (!!(var))
 
-#define TRACK_CALL(__call)                                       \
-	printf("Call '%s' at %s:%d\n", #__call, __FILE__, __LINE__); \
-	__call
+#if defined(_BEDROCK_PROFILE_) && !defined(_BEDROCK_KERNEL_)
+#	define BEDROCK_CONCAT_IMPL(a, b) a##b
+#	define BEDROCK_CONCAT(a, b)      BEDROCK_CONCAT_IMPL(a, b)
+
+// NOTE: When profiling, the tracked call is timed as a zone named after the call itself (see bedrock_profile.h),
+//       each expansion getting its own zone through __COUNTER__
+#	define TRACK_CALL(__call) TRACK_CALL_ZONE(__call, __COUNTER__)
+#	define TRACK_CALL_ZONE(__call, __id)                                         \
+		PROFILE_ZONE_BEGIN_NAMED(BEDROCK_CONCAT(__track_call_, __id), #__call);  \
+		__call;                                                                  \
+		PROFILE_ZONE_END(BEDROCK_CONCAT(__track_call_, __id))
+#else
+#	define TRACK_CALL(__call)                                       \
+		printf("Call '%s' at %s:%d\n", #__call, __FILE__, __LINE__); \
+		__call
+
+// Without the profiler every profiling macro expands to nothing, arguments included
+#	define PROFILE_ZONE_BEGIN_NAMED(zone, name)   ((void) 0)
+#	define PROFILE_ZONE_BEGIN(zone)               ((void) 0)
+#	define PROFILE_ZONE_END(zone)                 ((void) 0)
+#	define PROFILE_COUNTER_ADD(counter, delta)    ((void) 0)
+#	define PROFILE_COUNTER_INC(counter)           ((void) 0)
+#	define PROFILE_TRACE_START(events_per_thread) ((void) 0)
+#	define PROFILE_DUMP(file)                     ((void) 0)
+#	define PROFILE_WRITE_TRACE(path)              ((void) 0)
+#	define PROFILE_DEINIT()                       ((void) 0)
+#endif //_BEDROCK_PROFILE_
 
 #define SAFE_FREE(ptr) do { if ((ptr) != NULL) { free(ptr); (ptr) = NULL; } } while (0) 
 #define MULTI_FREE(...)                                     \
@@ -115,15 +163,58 @@
 		}                                                   \
 	} while(0)
 
-#define BE_CONVERT(ptr_val, size) be_to_le(ptr_val, size)
-#if defined(__BYTE_ORDER) && __BYTE_ORDER == __LITTLE_ENDIAN || \
-    defined(__LITTLE_ENDIAN__) ||                               \
-    defined(__ARMEL__) ||                                       \
-    defined(__THUMBEL__) ||                                     \
-    defined(__AARCH64EL__) ||                                   \
-    defined(_MIPSEL) || defined(__MIPSEL) || defined(__MIPSEL__)
+// NOTE: Prefer the compiler predefined byte order, as __BYTE_ORDER requires <endian.h> to be included first
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && defined(__ORDER_BIG_ENDIAN__)
+#	if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#		define _BEDROCK_LITTLE_ENDIAN_
+#	elif (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#		define _BEDROCK_BIG_ENDIAN_
+#	endif // __BYTE_ORDER__
+#elif (defined(__BYTE_ORDER) && defined(__LITTLE_ENDIAN) && (__BYTE_ORDER == __LITTLE_ENDIAN)) || \
+      defined(__LITTLE_ENDIAN__) ||                                                               \
+      defined(__ARMEL__) ||                                                                       \
+      defined(__THUMBEL__) ||                                                                     \
+      defined(__AARCH64EL__) ||                                                                   \
+      defined(_MIPSEL) || defined(__MIPSEL) || defined(__MIPSEL__)
+#	define _BEDROCK_LITTLE_ENDIAN_
+#elif (defined(__BYTE_ORDER) && defined(__BIG_ENDIAN) && (__BYTE_ORDER == __BIG_ENDIAN)) || \
+      defined(__BIG_ENDIAN__) ||                                                         \
+      defined(__ARMEB__) ||                                                              \
+      defined(__THUMBEB__) ||                                                            \
+      defined(__AARCH64EB__) ||                                                          \
+      defined(_MIPSEB) || defined(__MIPSEB) || defined(__MIPSEB__)
+#	define _BEDROCK_BIG_ENDIAN_
+#endif // CHECK_ENDIANNESS
+
+#if !defined(_BEDROCK_LITTLE_ENDIAN_) && !defined(_BEDROCK_BIG_ENDIAN_)
+#	error "Unable to detect the byte order of the target."
+#	include <stophere>
+#endif // CHECK_ENDIANNESS
 
+#define BE_CONVERT(ptr_val, size) be_to_le(ptr_val, size)
+#ifdef _BEDROCK_LITTLE_ENDIAN_
 	BEDROCK_FUNCTION void be_to_le(void* ptr_val, const u64 size) {
+		// Constant sizes are swapped through memcpy, so that unaligned pointers are safe as well
+		if (size == sizeof(u16)) {
+			u16 val = 0;
+			__builtin_memcpy(&val, ptr_val, sizeof(val));
+			val = __builtin_bswap16(val);
+			__builtin_memcpy(ptr_val, &val, sizeof(val));
+			return;
+		} else if (size == sizeof(u32)) {
+			u32 val = 0;
+			__builtin_memcpy(&val, ptr_val, sizeof(val));
+			val = __builtin_bswap32(val);
+			__builtin_memcpy(ptr_val, &val, sizeof(val));
+			return;
+		} else if (size == sizeof(u64)) {
+			u64 val = 0;
+			__builtin_memcpy(&val, ptr_val, sizeof(val));
+			val = __builtin_bswap64(val);
+			__builtin_memcpy(ptr_val, &val, sizeof(val));
+			return;
+		}
+
         for (u64 i = 0; i < size / 2; ++i) {
             unsigned char temp = CAST_PTR(ptr_val, u8)[i];
             CAST_PTR(ptr_val, u8)[i] = CAST_PTR(ptr_val, u8)[size - 1 - i];
@@ -133,7 +224,7 @@
     }
 #else
     #define be_to_le(ptr_val, size)
-#endif // CHECK_ENDIANNESS
+#endif // _BEDROCK_LITTLE_ENDIAN_
 
 #ifndef TRUE
 	#define TRUE  1
@@ -168,9 +259,47 @@
 #include "./bedrock_base.h"
 
 #ifdef _BEDROCK_VA_ARGS_
+#	ifdef _BEDROCK_KERNEL_
+#		include <linux/stdarg.h>
+#	else
+#		include <stdarg.h>
+#	endif //_BEDROCK_KERNEL_
 #	include "./bedrock_vargs.h"
 #endif //_BEDROCK_VA_ARGS_
 
+#ifdef _BEDROCK_TOKENIZER_
+#	include "./bedrock_tokenizer.h"
+#endif //_BEDROCK_TOKENIZER_
+
+#ifdef _BEDROCK_UTF8_
+#	include "./bedrock_utf8.h"
+#endif //_BEDROCK_UTF8_
+
+#ifdef _BEDROCK_ENDIAN_
+#	include "./bedrock_endian.h"
+#endif //_BEDROCK_ENDIAN_
+
+#ifdef _BEDROCK_BITS_
+#	include "./bedrock_bits.h"
+#endif //_BEDROCK_BITS_
+
+// NOTE: The thread pool injector is built on the MPMC queue
+#if defined(_BEDROCK_THREAD_POOL_) && !defined(_BEDROCK_QUEUE_)
+#	define _BEDROCK_QUEUE_
+#endif // _BEDROCK_THREAD_POOL_
+
+#ifdef _BEDROCK_QUEUE_
+#	include "./bedrock_queue.h"
+#endif //_BEDROCK_QUEUE_
+
+#ifdef _BEDROCK_SORT_
+#	include "./bedrock_sort.h"
+#endif //_BEDROCK_SORT_
+
+#ifdef _BEDROCK_DIVIDE_
+#	include "./bedrock_divide.h"
+#endif //_BEDROCK_DIVIDE_
+
 #ifndef _BEDROCK_USERSPACE_
 #	include "./bedrock_kernel.h"
 #endif //_BEDROCK_USERSPACE_
@@ -179,5 +308,9 @@
 #	include "./bedrock_userspace.h"
 #endif //_BEDROCK_KERNEL_
 
+#if defined(_BEDROCK_PROFILE_) && !defined(_BEDROCK_KERNEL_)
+#	include "./bedrock_profile.h"
+#endif //_BEDROCK_PROFILE_
+
 #endif //_BEDROCK_H_
 
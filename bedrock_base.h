@@ -9,6 +9,8 @@
 // NOTE: find_chr replaced with str_tok
 // NOTE: strip replaced with trim
 
+#define BEDROCK_MAX_U64_DIGITS 20
+
 #define mem_set(ptr, value, size)    mem_set_var(ptr, value, size, sizeof(u8))
 #define mem_set_32(ptr, value, size) mem_set_var(ptr, value, size, sizeof(u32))
 #define mem_set_64(ptr, value, size) mem_set_var(ptr, value, size, sizeof(u64))
@@ -39,12 +41,8 @@ BEDROCK_INLINE_FUNCTION u64 __ceil(const u64 a, const u64 b);
 
 /* -------------------------------------------------------------------------------------------------------- */
 BEDROCK_FUNCTION u8 bit_size(const u8 val) {
-	u8 size = 8;
-	for (s8 i = size - 1; i >= 0; --i) {
-		if (GET_BIT(val, i)) break;
-		size--;
-	}
-	return size;
+	if (val == 0) return 0;
+	return (u8) (BITS_SIZE(unsigned int) - __builtin_clz(val));
 }
 
 BEDROCK_FUNCTION u64 str_len(const char* str) {
@@ -133,15 +131,18 @@ BEDROCK_FUNCTION char* to_dec_str(char* str, const u8* byte_str, const u64 byte_
 		val += byte_str[i - 1];
 	}
 	
-	char* const str_base = str;
-	while (val) {
-		mem_move(str_base + 1, str_base, str - str_base);
-		u8 value = val % 10;
-		*str_base = value + '0', str++;
-		val = (val - (val % 10)) / 10;
-	}
+	// The digits come out least significant first, so they are laid out backwards and copied once
+	char digits[BEDROCK_MAX_U64_DIGITS];
+	u8 digits_cnt = 0;
+	do {
+		digits[BEDROCK_MAX_U64_DIGITS - ++digits_cnt] = NUM_TO_CHR(val % 10);
+		val /= 10;
+	} while (val);
+
+	mem_cpy(str, digits + BEDROCK_MAX_U64_DIGITS - digits_cnt, digits_cnt);
+	str[digits_cnt] = '\0';
 	
-	return str_base;
+	return str;
 }
 
 BEDROCK_FUNCTION char* to_bit_str(char* str, const u8* byte_str, const u64 byte_size) {
@@ -294,9 +295,9 @@ BEDROCK_FUNCTION u64 bytes_len(const u8* val, const u64 len) {
 }
 
 BEDROCK_INLINE_FUNCTION u64 __ceil(const u64 a, const u64 b) {
-	u64 c = (a - (a % b)) / b;
-	if (a % b) c++;
-	return c;
+	// The remainder is recovered from the quotient, so that a single division is issued
+	const u64 c = a / b;
+	return c + (a != c * b);
 }
 
 #endif //_BEDROCK_BASE_H_
@@ -0,0 +1,464 @@
+#ifndef _BEDROCK_BITS_H_
+#define _BEDROCK_BITS_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ---------------------
+//  Bit Manipulation
+// ---------------------
+// Every width is implemented on top of the 64-bit primitives, which map to a single instruction
+// when the compiler builtins are available (clz/ctz are defined for zero and return the width).
+// NOTE: Without -mpopcnt the popcount builtin becomes a call to __popcountdi2 from libgcc,
+//       which kernel builds cannot link: defining _BEDROCK_NO_BUILTINS_ selects the SWAR fallbacks.
+#if !defined(_BEDROCK_NO_BUILTINS_) && (defined(__GNUC__) || defined(__clang__))
+#	define _BEDROCK_BIT_BUILTINS_
+#endif // _BEDROCK_NO_BUILTINS_
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_INLINE_FUNCTION u8 clz64(const u64 val);
+BEDROCK_INLINE_FUNCTION u8 ctz64(const u64 val);
+BEDROCK_INLINE_FUNCTION u8 popcount64(const u64 val);
+BEDROCK_INLINE_FUNCTION u64 bit_reverse64(u64 val);
+BEDROCK_INLINE_FUNCTION u8 clz32(const u32 val);
+BEDROCK_INLINE_FUNCTION u8 clz16(const u16 val);
+BEDROCK_INLINE_FUNCTION u8 clz8(const u8 val);
+BEDROCK_INLINE_FUNCTION u8 ctz32(const u32 val);
+BEDROCK_INLINE_FUNCTION u8 ctz16(const u16 val);
+BEDROCK_INLINE_FUNCTION u8 ctz8(const u8 val);
+BEDROCK_INLINE_FUNCTION u8 popcount32(const u32 val);
+BEDROCK_INLINE_FUNCTION u8 popcount16(const u16 val);
+BEDROCK_INLINE_FUNCTION u8 popcount8(const u8 val);
+BEDROCK_INLINE_FUNCTION u32 bit_reverse32(const u32 val);
+BEDROCK_INLINE_FUNCTION u16 bit_reverse16(const u16 val);
+BEDROCK_INLINE_FUNCTION u8 bit_reverse8(const u8 val);
+BEDROCK_INLINE_FUNCTION u64 rotl64(const u64 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u32 rotl32(const u32 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u16 rotl16(const u16 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u8 rotl8(const u8 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u64 rotr64(const u64 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u32 rotr32(const u32 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u16 rotr16(const u16 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u8 rotr8(const u8 val, const u8 shift);
+
+#ifdef __SIZEOF_INT128__
+BEDROCK_INLINE_FUNCTION u8 clz128(const u128 val);
+BEDROCK_INLINE_FUNCTION u8 ctz128(const u128 val);
+BEDROCK_INLINE_FUNCTION u8 popcount128(const u128 val);
+BEDROCK_INLINE_FUNCTION u128 bit_reverse128(const u128 val);
+BEDROCK_INLINE_FUNCTION u128 rotl128(const u128 val, const u8 shift);
+BEDROCK_INLINE_FUNCTION u128 rotr128(const u128 val, const u8 shift);
+#endif //__SIZEOF_INT128__
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_INLINE_FUNCTION u8 clz64(const u64 val) {
+	if (val == 0) return 64;
+#ifdef _BEDROCK_BIT_BUILTINS_
+	return (u8) __builtin_clzll(val);
+#else
+	u8 cnt = 0;
+	u64 tmp = val;
+	if (!(tmp & 0xFFFFFFFF00000000ULL)) cnt += 32, tmp <<= 32;
+	if (!(tmp & 0xFFFF000000000000ULL)) cnt += 16, tmp <<= 16;
+	if (!(tmp & 0xFF00000000000000ULL)) cnt += 8, tmp <<= 8;
+	if (!(tmp & 0xF000000000000000ULL)) cnt += 4, tmp <<= 4;
+	if (!(tmp & 0xC000000000000000ULL)) cnt += 2, tmp <<= 2;
+	if (!(tmp & 0x8000000000000000ULL)) cnt += 1;
+	return cnt;
+#endif // _BEDROCK_BIT_BUILTINS_
+}
+
+BEDROCK_INLINE_FUNCTION u8 ctz64(const u64 val) {
+	if (val == 0) return 64;
+#ifdef _BEDROCK_BIT_BUILTINS_
+	return (u8) __builtin_ctzll(val);
+#else
+	// Isolate the lowest set bit, then count the ones preceding it
+	return popcount64((val & (0ULL - val)) - 1);
+#endif // _BEDROCK_BIT_BUILTINS_
+}
+
+BEDROCK_INLINE_FUNCTION u8 popcount64(const u64 val) {
+#ifdef _BEDROCK_BIT_BUILTINS_
+	return (u8) __builtin_popcountll(val);
+#else
+	u64 tmp = val - ((val >> 1) & 0x5555555555555555ULL);
+	tmp = (tmp & 0x3333333333333333ULL) + ((tmp >> 2) & 0x3333333333333333ULL);
+	tmp = (tmp + (tmp >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (u8) ((tmp * 0x0101010101010101ULL) >> 56);
+#endif // _BEDROCK_BIT_BUILTINS_
+}
+
+BEDROCK_INLINE_FUNCTION u64 bit_reverse64(u64 val) {
+#if defined(_BEDROCK_BIT_BUILTINS_) && defined(__clang__)
+	return __builtin_bitreverse64(val);
+#else
+#	ifdef _BEDROCK_BIT_BUILTINS_
+	val = __builtin_bswap64(val);
+#	else
+	val = ((val >> 8) & 0x00FF00FF00FF00FFULL) | ((val & 0x00FF00FF00FF00FFULL) << 8);
+	val = ((val >> 16) & 0x0000FFFF0000FFFFULL) | ((val & 0x0000FFFF0000FFFFULL) << 16);
+	val = (val >> 32) | (val << 32);
+#	endif // _BEDROCK_BIT_BUILTINS_
+	val = ((val >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((val & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	val = ((val >> 2) & 0x3333333333333333ULL) | ((val & 0x3333333333333333ULL) << 2);
+	val = ((val >> 1) & 0x5555555555555555ULL) | ((val & 0x5555555555555555ULL) << 1);
+	return val;
+#endif // __clang__
+}
+
+BEDROCK_INLINE_FUNCTION u8 clz32(const u32 val) {
+	return clz64(val) - 32;
+}
+
+BEDROCK_INLINE_FUNCTION u8 clz16(const u16 val) {
+	return clz64(val) - 48;
+}
+
+BEDROCK_INLINE_FUNCTION u8 clz8(const u8 val) {
+	return clz64(val) - 56;
+}
+
+BEDROCK_INLINE_FUNCTION u8 ctz32(const u32 val) {
+	return val ? ctz64(val) : 32;
+}
+
+BEDROCK_INLINE_FUNCTION u8 ctz16(const u16 val) {
+	return val ? ctz64(val) : 16;
+}
+
+BEDROCK_INLINE_FUNCTION u8 ctz8(const u8 val) {
+	return val ? ctz64(val) : 8;
+}
+
+BEDROCK_INLINE_FUNCTION u8 popcount32(const u32 val) {
+	return popcount64(val);
+}
+
+BEDROCK_INLINE_FUNCTION u8 popcount16(const u16 val) {
+	return popcount64(val);
+}
+
+BEDROCK_INLINE_FUNCTION u8 popcount8(const u8 val) {
+	return popcount64(val);
+}
+
+BEDROCK_INLINE_FUNCTION u32 bit_reverse32(const u32 val) {
+	return (u32) (bit_reverse64(val) >> 32);
+}
+
+BEDROCK_INLINE_FUNCTION u16 bit_reverse16(const u16 val) {
+	return (u16) (bit_reverse64(val) >> 48);
+}
+
+BEDROCK_INLINE_FUNCTION u8 bit_reverse8(const u8 val) {
+	return (u8) (bit_reverse64(val) >> 56);
+}
+
+// NOTE: The masked shifts avoid the undefined shift by the full width and are recognized as rol/ror
+BEDROCK_INLINE_FUNCTION u64 rotl64(const u64 val, const u8 shift) {
+	return (val << (shift & 63)) | (val >> (-shift & 63));
+}
+
+BEDROCK_INLINE_FUNCTION u32 rotl32(const u32 val, const u8 shift) {
+	return (val << (shift & 31)) | (val >> (-shift & 31));
+}
+
+BEDROCK_INLINE_FUNCTION u16 rotl16(const u16 val, const u8 shift) {
+	return (u16) ((val << (shift & 15)) | (val >> (-shift & 15)));
+}
+
+BEDROCK_INLINE_FUNCTION u8 rotl8(const u8 val, const u8 shift) {
+	return (u8) ((val << (shift & 7)) | (val >> (-shift & 7)));
+}
+
+BEDROCK_INLINE_FUNCTION u64 rotr64(const u64 val, const u8 shift) {
+	return (val >> (shift & 63)) | (val << (-shift & 63));
+}
+
+BEDROCK_INLINE_FUNCTION u32 rotr32(const u32 val, const u8 shift) {
+	return (val >> (shift & 31)) | (val << (-shift & 31));
+}
+
+BEDROCK_INLINE_FUNCTION u16 rotr16(const u16 val, const u8 shift) {
+	return (u16) ((val >> (shift & 15)) | (val << (-shift & 15)));
+}
+
+BEDROCK_INLINE_FUNCTION u8 rotr8(const u8 val, const u8 shift) {
+	return (u8) ((val >> (shift & 7)) | (val << (-shift & 7)));
+}
+
+#ifdef __SIZEOF_INT128__
+BEDROCK_INLINE_FUNCTION u8 clz128(const u128 val) {
+	const u64 hi = (u64) (val >> 64);
+	return hi ? clz64(hi) : 64 + clz64((u64) val);
+}
+
+BEDROCK_INLINE_FUNCTION u8 ctz128(const u128 val) {
+	const u64 lo = (u64) val;
+	return lo ? ctz64(lo) : 64 + ctz64((u64) (val >> 64));
+}
+
+BEDROCK_INLINE_FUNCTION u8 popcount128(const u128 val) {
+	return popcount64((u64) val) + popcount64((u64) (val >> 64));
+}
+
+BEDROCK_INLINE_FUNCTION u128 bit_reverse128(const u128 val) {
+	return ((u128) bit_reverse64((u64) val) << 64) | bit_reverse64((u64) (val >> 64));
+}
+
+BEDROCK_INLINE_FUNCTION u128 rotl128(const u128 val, const u8 shift) {
+	return (val << (shift & 127)) | (val >> (-shift & 127));
+}
+
+BEDROCK_INLINE_FUNCTION u128 rotr128(const u128 val, const u8 shift) {
+	return (val >> (shift & 127)) | (val << (-shift & 127));
+}
+#endif //__SIZEOF_INT128__
+
+/* -------------------------------------------------------------------------------------------------------- */
+// --------
+//  Bitset
+// --------
+// The words are allocated in groups of BITSET_WORDS_ALIGN (a full AVX2 register), so the bulk
+// operations never need a scalar tail; the bits past the size are always kept cleared.
+#define BITSET_WORD_BITS   64
+#define BITSET_WORDS_ALIGN 4
+#define BITSET_WORDS(bits) (__ceil((bits), BITSET_WORD_BITS * BITSET_WORDS_ALIGN) * BITSET_WORDS_ALIGN)
+
+#define BITSET_FOR_EACH(bitset, index) for (u64 index = bitset_next_set(bitset, 0); index < (bitset) -> bits; index = bitset_next_set(bitset, index + 1))
+
+typedef struct BedrockBitset {
+	u64* words;
+	u64 words_cnt;
+	u64 bits;
+} BedrockBitset;
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_FUNCTION int bitset_init(BedrockBitset* bitset, const u64 bits);
+BEDROCK_FUNCTION void bitset_deinit(BedrockBitset* bitset);
+BEDROCK_FUNCTION int bitset_resize(BedrockBitset* bitset, const u64 bits);
+BEDROCK_INLINE_FUNCTION void bitset_set(BedrockBitset* bitset, const u64 index);
+BEDROCK_INLINE_FUNCTION void bitset_clear(BedrockBitset* bitset, const u64 index);
+BEDROCK_INLINE_FUNCTION void bitset_flip(BedrockBitset* bitset, const u64 index);
+BEDROCK_INLINE_FUNCTION bool bitset_test(const BedrockBitset* bitset, const u64 index);
+BEDROCK_FUNCTION void bitset_set_all(BedrockBitset* bitset);
+BEDROCK_FUNCTION void bitset_clear_all(BedrockBitset* bitset);
+BEDROCK_FUNCTION int bitset_and(BedrockBitset* dest, const BedrockBitset* src);
+BEDROCK_FUNCTION int bitset_or(BedrockBitset* dest, const BedrockBitset* src);
+BEDROCK_FUNCTION int bitset_xor(BedrockBitset* dest, const BedrockBitset* src);
+BEDROCK_FUNCTION int bitset_andnot(BedrockBitset* dest, const BedrockBitset* src);
+BEDROCK_FUNCTION u64 bitset_popcount(const BedrockBitset* bitset);
+BEDROCK_FUNCTION u64 bitset_next_set(const BedrockBitset* bitset, const u64 from);
+BEDROCK_FUNCTION u64 bitset_next_clear(const BedrockBitset* bitset, const u64 from);
+BEDROCK_FUNCTION u64 bitset_to_indices(const BedrockBitset* bitset, u64* indices);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_FUNCTION int bitset_init(BedrockBitset* bitset, const u64 bits) {
+	if (bitset == NULL) return -1;
+
+	bitset -> bits = bits;
+	bitset -> words_cnt = BITSET_WORDS(bits);
+	bitset -> words = NULL;
+	if (bitset -> words_cnt == 0) return 0;
+
+	bitset -> words = (u64*) bedrock_calloc(bitset -> words_cnt, sizeof(u64));
+	if (bitset -> words == NULL) {
+		BEDROCK_WARNING_LOG("Failed to allocate the bitset words of %llu bits.", bits);
+		bitset -> bits = 0, bitset -> words_cnt = 0;
+		return -1;
+	}
+
+	return 0;
+}
+
+BEDROCK_FUNCTION void bitset_deinit(BedrockBitset* bitset) {
+	if (bitset == NULL) return;
+	bedrock_free(bitset -> words);
+	bitset -> words = NULL;
+	bitset -> words_cnt = 0;
+	bitset -> bits = 0;
+	return;
+}
+
+BEDROCK_FUNCTION int bitset_resize(BedrockBitset* bitset, const u64 bits) {
+	if (bitset == NULL) return -1;
+
+	const u64 words_cnt = BITSET_WORDS(bits);
+	if (words_cnt != bitset -> words_cnt) {
+		u64* words = (u64*) bedrock_realloc(bitset -> words, words_cnt * sizeof(u64));
+		if (words == NULL && words_cnt != 0) {
+			BEDROCK_WARNING_LOG("Failed to reallocate the bitset words to %llu bits.", bits);
+			return -1;
+		}
+		if (words_cnt > bitset -> words_cnt) mem_set(words + bitset -> words_cnt, 0, (words_cnt - bitset -> words_cnt) * sizeof(u64));
+		bitset -> words = words;
+		bitset -> words_cnt = words_cnt;
+	}
+
+	// Clear the bits dropped by a shrink within the last word
+	if (bits < bitset -> bits && (bits % BITSET_WORD_BITS)) bitset -> words[bits / BITSET_WORD_BITS] &= MASK_BITS_PRECEDING(bits % BITSET_WORD_BITS);
+	for (u64 i = __ceil(bits, BITSET_WORD_BITS); i < words_cnt && bits < bitset -> bits; ++i) bitset -> words[i] = 0;
+	bitset -> bits = bits;
+
+	return 0;
+}
+
+BEDROCK_INLINE_FUNCTION void bitset_set(BedrockBitset* bitset, const u64 index) {
+	bitset -> words[index / BITSET_WORD_BITS] |= 1ULL << (index % BITSET_WORD_BITS);
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void bitset_clear(BedrockBitset* bitset, const u64 index) {
+	bitset -> words[index / BITSET_WORD_BITS] &= ~(1ULL << (index % BITSET_WORD_BITS));
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void bitset_flip(BedrockBitset* bitset, const u64 index) {
+	bitset -> words[index / BITSET_WORD_BITS] ^= 1ULL << (index % BITSET_WORD_BITS);
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION bool bitset_test(const BedrockBitset* bitset, const u64 index) {
+	return GET_BIT(bitset -> words[index / BITSET_WORD_BITS], index % BITSET_WORD_BITS);
+}
+
+BEDROCK_FUNCTION void bitset_set_all(BedrockBitset* bitset) {
+	if (bitset == NULL || bitset -> words == NULL) return;
+	const u64 full_words = bitset -> bits / BITSET_WORD_BITS;
+	for (u64 i = 0; i < full_words; ++i) bitset -> words[i] = ~0ULL;
+	if (bitset -> bits % BITSET_WORD_BITS) bitset -> words[full_words] = MASK_BITS_PRECEDING(bitset -> bits % BITSET_WORD_BITS);
+	return;
+}
+
+BEDROCK_FUNCTION void bitset_clear_all(BedrockBitset* bitset) {
+	if (bitset == NULL || bitset -> words == NULL) return;
+	for (u64 i = 0; i < bitset -> words_cnt; ++i) bitset -> words[i] = 0;
+	return;
+}
+
+#if defined(_BEDROCK_AVX2_)
+#	define BITSET_BINARY_OP(name, avx2_op, sse2_op, scalar_op)                                   \
+	BEDROCK_FUNCTION int name(BedrockBitset* dest, const BedrockBitset* src) {                   \
+		if (dest == NULL || src == NULL || dest -> bits != src -> bits) return -1;               \
+		for (u64 i = 0; i < dest -> words_cnt; i += BITSET_WORDS_ALIGN) {                        \
+			const __m256i a = _mm256_loadu_si256((const __m256i*) (dest -> words + i));          \
+			const __m256i b = _mm256_loadu_si256((const __m256i*) (src -> words + i));           \
+			_mm256_storeu_si256((__m256i*) (dest -> words + i), avx2_op);                        \
+		}                                                                                        \
+		return 0;                                                                                \
+	}
+#elif defined(_BEDROCK_SSE2_)
+#	define BITSET_BINARY_OP(name, avx2_op, sse2_op, scalar_op)                                   \
+	BEDROCK_FUNCTION int name(BedrockBitset* dest, const BedrockBitset* src) {                   \
+		if (dest == NULL || src == NULL || dest -> bits != src -> bits) return -1;               \
+		for (u64 i = 0; i < dest -> words_cnt; i += 2) {                                         \
+			const __m128i a = _mm_loadu_si128((const __m128i*) (dest -> words + i));             \
+			const __m128i b = _mm_loadu_si128((const __m128i*) (src -> words + i));              \
+			_mm_storeu_si128((__m128i*) (dest -> words + i), sse2_op);                           \
+		}                                                                                        \
+		return 0;                                                                                \
+	}
+#else
+#	define BITSET_BINARY_OP(name, avx2_op, sse2_op, scalar_op)                                   \
+	BEDROCK_FUNCTION int name(BedrockBitset* dest, const BedrockBitset* src) {                   \
+		if (dest == NULL || src == NULL || dest -> bits != src -> bits) return -1;               \
+		for (u64 i = 0; i < dest -> words_cnt; ++i) {                                            \
+			const u64 a = dest -> words[i];                                                      \
+			const u64 b = src -> words[i];                                                       \
+			dest -> words[i] = scalar_op;                                                        \
+		}                                                                                        \
+		return 0;                                                                                \
+	}
+#endif // _BEDROCK_AVX2_
+
+BITSET_BINARY_OP(bitset_and, _mm256_and_si256(a, b), _mm_and_si128(a, b), a & b)
+BITSET_BINARY_OP(bitset_or, _mm256_or_si256(a, b), _mm_or_si128(a, b), a | b)
+BITSET_BINARY_OP(bitset_xor, _mm256_xor_si256(a, b), _mm_xor_si128(a, b), a ^ b)
+BITSET_BINARY_OP(bitset_andnot, _mm256_andnot_si256(b, a), _mm_andnot_si128(b, a), a & ~b)
+
+BEDROCK_FUNCTION u64 bitset_popcount(const BedrockBitset* bitset) {
+	if (bitset == NULL) return 0;
+
+	u64 cnt = 0;
+	u64 i = 0;
+#if defined(_BEDROCK_AVX2_)
+	// Nibble lookup popcount (Mula), with the byte counts summed through psadbw
+	const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+	__m256i acc = _mm256_setzero_si256();
+	for (; i < bitset -> words_cnt; i += BITSET_WORDS_ALIGN) {
+		const __m256i chunk = _mm256_loadu_si256((const __m256i*) (bitset -> words + i));
+		const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(chunk, low_nibble));
+		const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_nibble));
+		acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+	}
+	cnt += (u64) _mm256_extract_epi64(acc, 0) + (u64) _mm256_extract_epi64(acc, 1) + (u64) _mm256_extract_epi64(acc, 2) + (u64) _mm256_extract_epi64(acc, 3);
+#endif // _BEDROCK_AVX2_
+
+	for (; i < bitset -> words_cnt; ++i) cnt += popcount64(bitset -> words[i]);
+
+	return cnt;
+}
+
+/// Returns the index of the first set bit at or after from, or bitset -> bits if there is none.
+BEDROCK_FUNCTION u64 bitset_next_set(const BedrockBitset* bitset, const u64 from) {
+	if (bitset == NULL || from >= bitset -> bits) return bitset == NULL ? 0 : bitset -> bits;
+
+	u64 word_index = from / BITSET_WORD_BITS;
+	u64 word = bitset -> words[word_index] & ~MASK_BITS_PRECEDING(from % BITSET_WORD_BITS);
+	while (word == 0) {
+		if (++word_index >= bitset -> words_cnt) return bitset -> bits;
+		word = bitset -> words[word_index];
+	}
+
+	return MIN(word_index * BITSET_WORD_BITS + ctz64(word), bitset -> bits);
+}
+
+/// Returns the index of the first cleared bit at or after from, or bitset -> bits if there is none.
+BEDROCK_FUNCTION u64 bitset_next_clear(const BedrockBitset* bitset, const u64 from) {
+	if (bitset == NULL || from >= bitset -> bits) return bitset == NULL ? 0 : bitset -> bits;
+
+	u64 word_index = from / BITSET_WORD_BITS;
+	u64 word = ~(bitset -> words[word_index]) & ~MASK_BITS_PRECEDING(from % BITSET_WORD_BITS);
+	while (word == 0) {
+		if (++word_index >= bitset -> words_cnt) return bitset -> bits;
+		word = ~(bitset -> words[word_index]);
+	}
+
+	return MIN(word_index * BITSET_WORD_BITS + ctz64(word), bitset -> bits);
+}
+
+/// Writes the index of every set bit into indices, which must hold at least bitset_popcount() + 3 entries.
+BEDROCK_FUNCTION u64 bitset_to_indices(const BedrockBitset* bitset, u64* indices) {
+	if (bitset == NULL || indices == NULL) return 0;
+
+	u64* out = indices;
+	for (u64 i = 0; i < bitset -> words_cnt; ++i) {
+		u64 word = bitset -> words[i];
+		if (word == 0) continue;
+
+		const u64 base = i * BITSET_WORD_BITS;
+		u64* const next = out + popcount64(word);
+		while (out < next) {
+			out[0] = base + ctz64(word) % BITSET_WORD_BITS, word &= word - 1;
+			out[1] = base + ctz64(word) % BITSET_WORD_BITS, word &= word - 1;
+			out[2] = base + ctz64(word) % BITSET_WORD_BITS, word &= word - 1;
+			out[3] = base + ctz64(word) % BITSET_WORD_BITS, word &= word - 1;
+			out += 4;
+		}
+		out = next;
+	}
+
+	return (u64) (out - indices);
+}
+
+#endif //_BEDROCK_BITS_H_
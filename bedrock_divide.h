@@ -0,0 +1,224 @@
+#ifndef _BEDROCK_DIVIDE_H_
+#define _BEDROCK_DIVIDE_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ----------------------------
+//  Divide by Runtime Constant
+// ----------------------------
+// A divisor known only at runtime, but reused across many divisions, is turned once into a magic
+// multiplier and a shift (libdivide's round-up method), so each division becomes a high multiply,
+// an optional add and a shift instead of a div instruction.
+// - more holds the shift in its low bits, plus DIVIDER_ADD_MARKER when the magic needed 33/65 bits;
+// - magic is 0 for powers of two, which then only take the shift.
+// BedrockPow2Divider is the check-free variant for divisors already known to be powers of two.
+//
+// Usage:
+//   BedrockDividerU64 div = {0};
+//   if (divider_u64_init(&div, shards_cnt)) return -1;
+//   for (...) shard = divider_u64_mod(&div, hash);
+#define DIVIDER_SHIFT_MASK 0x3F
+#define DIVIDER_ADD_MARKER 0x40
+
+typedef struct BedrockDividerU32 {
+	u32 magic;
+	u32 divisor;
+	u8 more;
+} BedrockDividerU32;
+
+typedef struct BedrockDividerU64 {
+	u64 magic;
+	u64 divisor;
+	u8 more;
+} BedrockDividerU64;
+
+typedef struct BedrockPow2Divider {
+	u64 mask;
+	u8 shift;
+} BedrockPow2Divider;
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_FUNCTION int divider_u32_init(BedrockDividerU32* div, const u32 divisor);
+BEDROCK_INLINE_FUNCTION u32 divider_u32_div(const BedrockDividerU32* div, const u32 val);
+BEDROCK_INLINE_FUNCTION u32 divider_u32_mod(const BedrockDividerU32* div, const u32 val);
+BEDROCK_INLINE_FUNCTION u32 divider_u32_divmod(const BedrockDividerU32* div, const u32 val, u32* rem);
+BEDROCK_INLINE_FUNCTION u32 divider_u32_ceil_div(const BedrockDividerU32* div, const u32 val);
+BEDROCK_FUNCTION int divider_u64_init(BedrockDividerU64* div, const u64 divisor);
+BEDROCK_INLINE_FUNCTION u64 divider_u64_div(const BedrockDividerU64* div, const u64 val);
+BEDROCK_INLINE_FUNCTION u64 divider_u64_mod(const BedrockDividerU64* div, const u64 val);
+BEDROCK_INLINE_FUNCTION u64 divider_u64_divmod(const BedrockDividerU64* div, const u64 val, u64* rem);
+BEDROCK_INLINE_FUNCTION u64 divider_u64_ceil_div(const BedrockDividerU64* div, const u64 val);
+BEDROCK_FUNCTION int pow2_divider_init(BedrockPow2Divider* div, const u64 divisor);
+BEDROCK_INLINE_FUNCTION u64 pow2_divider_div(const BedrockPow2Divider* div, const u64 val);
+BEDROCK_INLINE_FUNCTION u64 pow2_divider_mod(const BedrockPow2Divider* div, const u64 val);
+BEDROCK_INLINE_FUNCTION u64 pow2_divider_ceil_div(const BedrockPow2Divider* div, const u64 val);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_INLINE_FUNCTION u64 divide_mul_hi64(const u64 a, const u64 b) {
+#ifdef __SIZEOF_INT128__
+	return (u64) (((u128) a * b) >> 64);
+#else
+	const u64 a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+	const u64 b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+	const u64 lo_lo = a_lo * b_lo;
+	const u64 mid = a_hi * b_lo + (lo_lo >> 32);
+	const u64 mid2 = a_lo * b_hi + (mid & 0xFFFFFFFFULL);
+	return a_hi * b_hi + (mid >> 32) + (mid2 >> 32);
+#endif //__SIZEOF_INT128__
+}
+
+// Divides 2^(64 + exp) by divisor, whose top bit sits above exp so that the quotient fits in 64 bits
+BEDROCK_INLINE_FUNCTION u64 divide_pow2_by_u64(const u8 exp, const u64 divisor, u64* rem) {
+#ifdef __SIZEOF_INT128__
+	const u128 num = (u128) 1 << (64 + exp);
+	*rem = (u64) (num % divisor);
+	return (u64) (num / divisor);
+#else
+	// Restoring long division, the remainder being kept below the divisor at every step
+	u64 quot = 0;
+	u64 r = 1ULL << exp;
+	for (u8 i = 0; i < 64; ++i) {
+		const bool carry = r >> 63;
+		r <<= 1, quot <<= 1;
+		if (carry || r >= divisor) r -= divisor, quot |= 1;
+	}
+	*rem = r;
+	return quot;
+#endif //__SIZEOF_INT128__
+}
+
+BEDROCK_FUNCTION int divider_u32_init(BedrockDividerU32* div, const u32 divisor) {
+	if (div == NULL) return -1;
+	if (divisor == 0) {
+		BEDROCK_WARNING_LOG("Cannot build a divider for a zero divisor.");
+		return -1;
+	}
+
+	const u8 floor_log2 = (u8) (31 - __builtin_clz(divisor));
+	div -> divisor = divisor;
+	if ((divisor & (divisor - 1)) == 0) {
+		div -> magic = 0;
+		div -> more = floor_log2;
+		return 0;
+	}
+
+	const u64 num = 1ULL << (32 + floor_log2);
+	u32 magic = (u32) (num / divisor);
+	const u32 rem = (u32) (num % divisor);
+	if (divisor - rem < (1U << floor_log2)) {
+		div -> more = floor_log2;
+	} else {
+		// The rounded magic would need 33 bits, keep 32 and add the numerator back when dividing
+		magic += magic;
+		const u32 twice_rem = rem + rem;
+		if (twice_rem >= divisor || twice_rem < rem) magic += 1;
+		div -> more = floor_log2 | DIVIDER_ADD_MARKER;
+	}
+	div -> magic = magic + 1;
+
+	return 0;
+}
+
+BEDROCK_INLINE_FUNCTION u32 divider_u32_div(const BedrockDividerU32* div, const u32 val) {
+	if (div -> magic == 0) return val >> div -> more;
+	const u32 quot = (u32) (((u64) div -> magic * val) >> 32);
+	if (div -> more & DIVIDER_ADD_MARKER) return (((val - quot) >> 1) + quot) >> (div -> more & DIVIDER_SHIFT_MASK);
+	return quot >> div -> more;
+}
+
+BEDROCK_INLINE_FUNCTION u32 divider_u32_mod(const BedrockDividerU32* div, const u32 val) {
+	return val - divider_u32_div(div, val) * div -> divisor;
+}
+
+BEDROCK_INLINE_FUNCTION u32 divider_u32_divmod(const BedrockDividerU32* div, const u32 val, u32* rem) {
+	const u32 quot = divider_u32_div(div, val);
+	*rem = val - quot * div -> divisor;
+	return quot;
+}
+
+BEDROCK_INLINE_FUNCTION u32 divider_u32_ceil_div(const BedrockDividerU32* div, const u32 val) {
+	const u32 quot = divider_u32_div(div, val);
+	return quot + (val != quot * div -> divisor);
+}
+
+BEDROCK_FUNCTION int divider_u64_init(BedrockDividerU64* div, const u64 divisor) {
+	if (div == NULL) return -1;
+	if (divisor == 0) {
+		BEDROCK_WARNING_LOG("Cannot build a divider for a zero divisor.");
+		return -1;
+	}
+
+	const u8 floor_log2 = (u8) (63 - __builtin_clzll(divisor));
+	div -> divisor = divisor;
+	if ((divisor & (divisor - 1)) == 0) {
+		div -> magic = 0;
+		div -> more = floor_log2;
+		return 0;
+	}
+
+	u64 rem = 0;
+	u64 magic = divide_pow2_by_u64(floor_log2, divisor, &rem);
+	if (divisor - rem < (1ULL << floor_log2)) {
+		div -> more = floor_log2;
+	} else {
+		// The rounded magic would need 65 bits, keep 64 and add the numerator back when dividing
+		magic += magic;
+		const u64 twice_rem = rem + rem;
+		if (twice_rem >= divisor || twice_rem < rem) magic += 1;
+		div -> more = floor_log2 | DIVIDER_ADD_MARKER;
+	}
+	div -> magic = magic + 1;
+
+	return 0;
+}
+
+BEDROCK_INLINE_FUNCTION u64 divider_u64_div(const BedrockDividerU64* div, const u64 val) {
+	if (div -> magic == 0) return val >> div -> more;
+	const u64 quot = divide_mul_hi64(div -> magic, val);
+	if (div -> more & DIVIDER_ADD_MARKER) return (((val - quot) >> 1) + quot) >> (div -> more & DIVIDER_SHIFT_MASK);
+	return quot >> div -> more;
+}
+
+BEDROCK_INLINE_FUNCTION u64 divider_u64_mod(const BedrockDividerU64* div, const u64 val) {
+	return val - divider_u64_div(div, val) * div -> divisor;
+}
+
+BEDROCK_INLINE_FUNCTION u64 divider_u64_divmod(const BedrockDividerU64* div, const u64 val, u64* rem) {
+	const u64 quot = divider_u64_div(div, val);
+	*rem = val - quot * div -> divisor;
+	return quot;
+}
+
+BEDROCK_INLINE_FUNCTION u64 divider_u64_ceil_div(const BedrockDividerU64* div, const u64 val) {
+	const u64 quot = divider_u64_div(div, val);
+	return quot + (val != quot * div -> divisor);
+}
+
+BEDROCK_FUNCTION int pow2_divider_init(BedrockPow2Divider* div, const u64 divisor) {
+	if (div == NULL) return -1;
+	if (divisor == 0 || (divisor & (divisor - 1))) {
+		BEDROCK_WARNING_LOG("The divisor %llu is not a power of two.", divisor);
+		return -1;
+	}
+	div -> shift = (u8) __builtin_ctzll(divisor);
+	div -> mask = divisor - 1;
+	return 0;
+}
+
+BEDROCK_INLINE_FUNCTION u64 pow2_divider_div(const BedrockPow2Divider* div, const u64 val) {
+	return val >> div -> shift;
+}
+
+BEDROCK_INLINE_FUNCTION u64 pow2_divider_mod(const BedrockPow2Divider* div, const u64 val) {
+	return val & div -> mask;
+}
+
+BEDROCK_INLINE_FUNCTION u64 pow2_divider_ceil_div(const BedrockPow2Divider* div, const u64 val) {
+	return (val >> div -> shift) + ((val & div -> mask) != 0);
+}
+
+#endif //_BEDROCK_DIVIDE_H_
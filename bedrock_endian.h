@@ -0,0 +1,239 @@
+#ifndef _BEDROCK_ENDIAN_H_
+#define _BEDROCK_ENDIAN_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ------------------------
+//  Endianness Conversions
+// ------------------------
+// The typed load/store helpers go through memcpy, which the compiler lowers to a single
+// (unaligned) move, followed by a bswap instruction only when the byte order differs.
+#ifdef _BEDROCK_LITTLE_ENDIAN_
+#	define HOST_TO_LE16(val) ((u16) (val))
+#	define HOST_TO_LE32(val) ((u32) (val))
+#	define HOST_TO_LE64(val) ((u64) (val))
+#	define HOST_TO_BE16(val) __builtin_bswap16(val)
+#	define HOST_TO_BE32(val) __builtin_bswap32(val)
+#	define HOST_TO_BE64(val) __builtin_bswap64(val)
+#else
+#	define HOST_TO_LE16(val) __builtin_bswap16(val)
+#	define HOST_TO_LE32(val) __builtin_bswap32(val)
+#	define HOST_TO_LE64(val) __builtin_bswap64(val)
+#	define HOST_TO_BE16(val) ((u16) (val))
+#	define HOST_TO_BE32(val) ((u32) (val))
+#	define HOST_TO_BE64(val) ((u64) (val))
+#endif // _BEDROCK_LITTLE_ENDIAN_
+
+#define LE16_TO_HOST(val) HOST_TO_LE16(val)
+#define LE32_TO_HOST(val) HOST_TO_LE32(val)
+#define LE64_TO_HOST(val) HOST_TO_LE64(val)
+#define BE16_TO_HOST(val) HOST_TO_BE16(val)
+#define BE32_TO_HOST(val) HOST_TO_BE32(val)
+#define BE64_TO_HOST(val) HOST_TO_BE64(val)
+
+// Bulk conversions, dest may be equal to src for in-place conversions, but must not partially overlap it
+#ifdef _BEDROCK_LITTLE_ENDIAN_
+#	define load_be16_arr(dest, src, cnt)  bswap16_arr(dest, src, cnt)
+#	define load_be32_arr(dest, src, cnt)  bswap32_arr(dest, src, cnt)
+#	define load_be64_arr(dest, src, cnt)  bswap64_arr(dest, src, cnt)
+#	define load_le16_arr(dest, src, cnt)  endian_copy_arr(dest, src, (cnt) * sizeof(u16))
+#	define load_le32_arr(dest, src, cnt)  endian_copy_arr(dest, src, (cnt) * sizeof(u32))
+#	define load_le64_arr(dest, src, cnt)  endian_copy_arr(dest, src, (cnt) * sizeof(u64))
+#else
+#	define load_be16_arr(dest, src, cnt)  endian_copy_arr(dest, src, (cnt) * sizeof(u16))
+#	define load_be32_arr(dest, src, cnt)  endian_copy_arr(dest, src, (cnt) * sizeof(u32))
+#	define load_be64_arr(dest, src, cnt)  endian_copy_arr(dest, src, (cnt) * sizeof(u64))
+#	define load_le16_arr(dest, src, cnt)  bswap16_arr(dest, src, cnt)
+#	define load_le32_arr(dest, src, cnt)  bswap32_arr(dest, src, cnt)
+#	define load_le64_arr(dest, src, cnt)  bswap64_arr(dest, src, cnt)
+#endif // _BEDROCK_LITTLE_ENDIAN_
+
+#define store_be16_arr(dest, src, cnt) load_be16_arr(dest, src, cnt)
+#define store_be32_arr(dest, src, cnt) load_be32_arr(dest, src, cnt)
+#define store_be64_arr(dest, src, cnt) load_be64_arr(dest, src, cnt)
+#define store_le16_arr(dest, src, cnt) load_le16_arr(dest, src, cnt)
+#define store_le32_arr(dest, src, cnt) load_le32_arr(dest, src, cnt)
+#define store_le64_arr(dest, src, cnt) load_le64_arr(dest, src, cnt)
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_INLINE_FUNCTION u16 load_le16(const void* ptr);
+BEDROCK_INLINE_FUNCTION u32 load_le32(const void* ptr);
+BEDROCK_INLINE_FUNCTION u64 load_le64(const void* ptr);
+BEDROCK_INLINE_FUNCTION u16 load_be16(const void* ptr);
+BEDROCK_INLINE_FUNCTION u32 load_be32(const void* ptr);
+BEDROCK_INLINE_FUNCTION u64 load_be64(const void* ptr);
+BEDROCK_INLINE_FUNCTION void store_le16(void* ptr, const u16 val);
+BEDROCK_INLINE_FUNCTION void store_le32(void* ptr, const u32 val);
+BEDROCK_INLINE_FUNCTION void store_le64(void* ptr, const u64 val);
+BEDROCK_INLINE_FUNCTION void store_be16(void* ptr, const u16 val);
+BEDROCK_INLINE_FUNCTION void store_be32(void* ptr, const u32 val);
+BEDROCK_INLINE_FUNCTION void store_be64(void* ptr, const u64 val);
+BEDROCK_FUNCTION void endian_copy_arr(void* dest, const void* src, const u64 size);
+BEDROCK_FUNCTION void bswap16_arr(void* dest, const void* src, const u64 cnt);
+BEDROCK_FUNCTION void bswap32_arr(void* dest, const void* src, const u64 cnt);
+BEDROCK_FUNCTION void bswap64_arr(void* dest, const void* src, const u64 cnt);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_INLINE_FUNCTION u16 load_le16(const void* ptr) {
+	u16 val = 0;
+	__builtin_memcpy(&val, ptr, sizeof(val));
+	return LE16_TO_HOST(val);
+}
+
+BEDROCK_INLINE_FUNCTION u32 load_le32(const void* ptr) {
+	u32 val = 0;
+	__builtin_memcpy(&val, ptr, sizeof(val));
+	return LE32_TO_HOST(val);
+}
+
+BEDROCK_INLINE_FUNCTION u64 load_le64(const void* ptr) {
+	u64 val = 0;
+	__builtin_memcpy(&val, ptr, sizeof(val));
+	return LE64_TO_HOST(val);
+}
+
+BEDROCK_INLINE_FUNCTION u16 load_be16(const void* ptr) {
+	u16 val = 0;
+	__builtin_memcpy(&val, ptr, sizeof(val));
+	return BE16_TO_HOST(val);
+}
+
+BEDROCK_INLINE_FUNCTION u32 load_be32(const void* ptr) {
+	u32 val = 0;
+	__builtin_memcpy(&val, ptr, sizeof(val));
+	return BE32_TO_HOST(val);
+}
+
+BEDROCK_INLINE_FUNCTION u64 load_be64(const void* ptr) {
+	u64 val = 0;
+	__builtin_memcpy(&val, ptr, sizeof(val));
+	return BE64_TO_HOST(val);
+}
+
+BEDROCK_INLINE_FUNCTION void store_le16(void* ptr, const u16 val) {
+	const u16 le_val = HOST_TO_LE16(val);
+	__builtin_memcpy(ptr, &le_val, sizeof(le_val));
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void store_le32(void* ptr, const u32 val) {
+	const u32 le_val = HOST_TO_LE32(val);
+	__builtin_memcpy(ptr, &le_val, sizeof(le_val));
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void store_le64(void* ptr, const u64 val) {
+	const u64 le_val = HOST_TO_LE64(val);
+	__builtin_memcpy(ptr, &le_val, sizeof(le_val));
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void store_be16(void* ptr, const u16 val) {
+	const u16 be_val = HOST_TO_BE16(val);
+	__builtin_memcpy(ptr, &be_val, sizeof(be_val));
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void store_be32(void* ptr, const u32 val) {
+	const u32 be_val = HOST_TO_BE32(val);
+	__builtin_memcpy(ptr, &be_val, sizeof(be_val));
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void store_be64(void* ptr, const u64 val) {
+	const u64 be_val = HOST_TO_BE64(val);
+	__builtin_memcpy(ptr, &be_val, sizeof(be_val));
+	return;
+}
+
+BEDROCK_FUNCTION void endian_copy_arr(void* dest, const void* src, const u64 size) {
+	if (dest == NULL || src == NULL || dest == src) return;
+	__builtin_memmove(dest, src, size);
+	return;
+}
+
+#if defined(_BEDROCK_SSSE3_)
+// Applies the byte shuffle to every full 16 (or 32) bytes block, returning the amount of bytes processed
+BEDROCK_INLINE_FUNCTION u64 endian_shuffle_blocks(u8* dest, const u8* src, const u64 size, const __m128i mask) {
+	u64 i = 0;
+
+#if defined(_BEDROCK_AVX2_)
+	// NOTE: vpshufb shuffles within each 128-bit lane, which is all a byte swap needs
+	const __m256i wide_mask = _mm256_broadcastsi128_si256(mask);
+	for (; (i + 32) <= size; i += 32) {
+		const __m256i chunk = _mm256_loadu_si256((const __m256i*) (src + i));
+		_mm256_storeu_si256((__m256i*) (dest + i), _mm256_shuffle_epi8(chunk, wide_mask));
+	}
+#endif // _BEDROCK_AVX2_
+
+	for (; (i + 16) <= size; i += 16) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i*) (src + i));
+		_mm_storeu_si128((__m128i*) (dest + i), _mm_shuffle_epi8(chunk, mask));
+	}
+
+	return i;
+}
+#endif // _BEDROCK_SSSE3_
+
+BEDROCK_FUNCTION void bswap16_arr(void* dest, const void* src, const u64 cnt) {
+	if (dest == NULL || src == NULL) return;
+
+	u64 i = 0;
+#if defined(_BEDROCK_SSSE3_)
+	const __m128i mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+	i = endian_shuffle_blocks(CAST_PTR(dest, u8), CAST_PTR(src, u8), cnt * sizeof(u16), mask) / sizeof(u16);
+#endif // _BEDROCK_SSSE3_
+
+	for (; i < cnt; ++i) {
+		u16 val = 0;
+		__builtin_memcpy(&val, CAST_PTR(src, u8) + i * sizeof(u16), sizeof(val));
+		val = __builtin_bswap16(val);
+		__builtin_memcpy(CAST_PTR(dest, u8) + i * sizeof(u16), &val, sizeof(val));
+	}
+
+	return;
+}
+
+BEDROCK_FUNCTION void bswap32_arr(void* dest, const void* src, const u64 cnt) {
+	if (dest == NULL || src == NULL) return;
+
+	u64 i = 0;
+#if defined(_BEDROCK_SSSE3_)
+	const __m128i mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	i = endian_shuffle_blocks(CAST_PTR(dest, u8), CAST_PTR(src, u8), cnt * sizeof(u32), mask) / sizeof(u32);
+#endif // _BEDROCK_SSSE3_
+
+	for (; i < cnt; ++i) {
+		u32 val = 0;
+		__builtin_memcpy(&val, CAST_PTR(src, u8) + i * sizeof(u32), sizeof(val));
+		val = __builtin_bswap32(val);
+		__builtin_memcpy(CAST_PTR(dest, u8) + i * sizeof(u32), &val, sizeof(val));
+	}
+
+	return;
+}
+
+BEDROCK_FUNCTION void bswap64_arr(void* dest, const void* src, const u64 cnt) {
+	if (dest == NULL || src == NULL) return;
+
+	u64 i = 0;
+#if defined(_BEDROCK_SSSE3_)
+	const __m128i mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	i = endian_shuffle_blocks(CAST_PTR(dest, u8), CAST_PTR(src, u8), cnt * sizeof(u64), mask) / sizeof(u64);
+#endif // _BEDROCK_SSSE3_
+
+	for (; i < cnt; ++i) {
+		u64 val = 0;
+		__builtin_memcpy(&val, CAST_PTR(src, u8) + i * sizeof(u64), sizeof(val));
+		val = __builtin_bswap64(val);
+		__builtin_memcpy(CAST_PTR(dest, u8) + i * sizeof(u64), &val, sizeof(val));
+	}
+
+	return;
+}
+
+#endif //_BEDROCK_ENDIAN_H_
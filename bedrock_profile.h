@@ -0,0 +1,487 @@
+#ifndef _BEDROCK_PROFILE_H_
+#define _BEDROCK_PROFILE_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------
+//  Profiling Zones
+// -----------------
+// Zones and counters register themselves on first use through a static id at the call site,
+// then every thread accumulates into its own stats block: recording never takes a lock nor
+// writes a shared cache line. Each field is written with a relaxed atomic store, so a snapshot
+// can be taken at any time from any thread.
+// Timestamps are raw rdtsc ticks where available (clock_gettime nanoseconds otherwise), and are
+// converted to nanoseconds only when reporting.
+//
+// The profile is the one piece of global state of bedrock, so it is only declared here: exactly one
+// translation unit must define _BEDROCK_PROFILE_IMPLEMENTATION_ before including bedrock.h, and all
+// the others then record into the same profile.
+// Without _BEDROCK_PROFILE_ (or in kernel space) this header is skipped, and bedrock.h defines every
+// macro to expand to nothing, arguments included.
+//
+// Usage:
+//   PROFILE_ZONE_BEGIN(parse);
+//   ...
+//   PROFILE_ZONE_END(parse);
+//   PROFILE_COUNTER_ADD(bytes_read, len);
+//   PROFILE_TRACE_START(1 << 16);     /* Record up to 65536 zones per thread for the trace */
+//   PROFILE_DUMP(stdout);
+//   PROFILE_WRITE_TRACE("trace.json"); /* Load into chrome://tracing or Perfetto */
+#include <time.h>
+
+#ifndef PROFILE_MAX_ZONES
+#	define PROFILE_MAX_ZONES 128
+#endif // PROFILE_MAX_ZONES
+
+#ifndef PROFILE_MAX_COUNTERS
+#	define PROFILE_MAX_COUNTERS 64
+#endif // PROFILE_MAX_COUNTERS
+
+#ifndef PROFILE_MAX_THREADS
+#	define PROFILE_MAX_THREADS 64
+#endif // PROFILE_MAX_THREADS
+
+#define PROFILE_HISTOGRAM_BUCKETS 64
+#define PROFILE_UNREGISTERED      0xFFFFFFFFU
+#define PROFILE_DISABLED          0xFFFFFFFEU
+
+#if defined(__x86_64__) || defined(__i386__)
+#	define PROFILE_TICKS() __builtin_ia32_rdtsc()
+#else
+#	define PROFILE_TICKS() profile_clock_ns()
+#endif // PROFILE_TICKS
+
+#define PROFILE_LOAD(ptr)       __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define PROFILE_STORE(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELAXED)
+
+#define PROFILE_ZONE_BEGIN_NAMED(zone, name)                                              \
+	static u32 BEDROCK_CONCAT(__profile_zone_id_, zone) = PROFILE_UNREGISTERED;           \
+	const u64 BEDROCK_CONCAT(__profile_zone_start_, zone) = profile_zone_begin(&BEDROCK_CONCAT(__profile_zone_id_, zone), name)
+#define PROFILE_ZONE_END(zone)                 profile_zone_end(&BEDROCK_CONCAT(__profile_zone_id_, zone), BEDROCK_CONCAT(__profile_zone_start_, zone))
+#define PROFILE_COUNTER_ADD(counter, delta)                                               \
+	do {                                                                                  \
+		static u32 __profile_counter_id = PROFILE_UNREGISTERED;                           \
+		profile_counter_add(&__profile_counter_id, #counter, delta);                      \
+	} while (0)
+#define PROFILE_TRACE_START(events_per_thread) profile_trace_start(events_per_thread)
+#define PROFILE_DUMP(file)                     profile_dump(file)
+#define PROFILE_WRITE_TRACE(path)              profile_write_chrome_trace(path)
+#define PROFILE_DEINIT()                       profile_deinit()
+#define PROFILE_ZONE_BEGIN(zone)               PROFILE_ZONE_BEGIN_NAMED(zone, #zone)
+#define PROFILE_COUNTER_INC(counter)           PROFILE_COUNTER_ADD(counter, 1)
+
+typedef struct BedrockProfileStats {
+	u64 count;
+	u64 total;
+	u64 min;
+	u64 max;
+	u64 histogram[PROFILE_HISTOGRAM_BUCKETS]; // Bucket i counts the durations in [2^i, 2^(i + 1)) ticks
+} BedrockProfileStats;
+
+typedef struct BedrockProfileEvent {
+	u64 start;
+	u64 end;
+	u32 zone;
+} BedrockProfileEvent;
+
+typedef struct BedrockProfileThread {
+	u32 tid;
+	BedrockProfileStats zones[PROFILE_MAX_ZONES];
+	u64 counters[PROFILE_MAX_COUNTERS];
+	BedrockProfileEvent* events;
+	u64 events_capacity;
+	u64 events_cnt;
+	u64 dropped_events;
+} BedrockProfileThread;
+
+typedef struct BedrockProfile {
+	const char* zones[PROFILE_MAX_ZONES];
+	u32 zones_cnt;
+	const char* counters[PROFILE_MAX_COUNTERS];
+	u32 counters_cnt;
+	BedrockProfileThread* threads[PROFILE_MAX_THREADS];
+	u32 threads_cnt;
+	u64 trace_capacity;
+	u32 generation;
+	u32 epoch_state;
+	u64 epoch_ticks;
+	u64 epoch_ns;
+} BedrockProfile;
+
+// The block of the current thread, dropped once the generation of the profile moves on (see profile_deinit)
+typedef struct BedrockProfileLocal {
+	BedrockProfileThread* thread;
+	u32 generation;
+	bool failed;        // the thread could not be registered
+	bool trace_failed;  // the trace buffer could not be allocated, the zones are no longer traced
+} BedrockProfileLocal;
+
+typedef struct BedrockProfileZoneReport {
+	const char* name;
+	BedrockProfileStats stats;
+} BedrockProfileZoneReport;
+
+typedef struct BedrockProfileCounterReport {
+	const char* name;
+	u64 value;
+} BedrockProfileCounterReport;
+
+typedef struct BedrockProfileSnapshot {
+	BedrockProfileZoneReport zones[PROFILE_MAX_ZONES];
+	u32 zones_cnt;
+	BedrockProfileCounterReport counters[PROFILE_MAX_COUNTERS];
+	u32 counters_cnt;
+	double ticks_per_ns;
+} BedrockProfileSnapshot;
+
+#ifdef _BEDROCK_PROFILE_IMPLEMENTATION_
+BedrockProfile bedrock_profile = {0};
+__thread BedrockProfileLocal bedrock_profile_local = {0};
+#else
+extern BedrockProfile bedrock_profile;
+extern __thread BedrockProfileLocal bedrock_profile_local;
+#endif //_BEDROCK_PROFILE_IMPLEMENTATION_
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_INLINE_FUNCTION u64 profile_zone_begin(u32* id, const char* name);
+BEDROCK_INLINE_FUNCTION void profile_zone_end(const u32* id, const u64 start);
+BEDROCK_INLINE_FUNCTION void profile_counter_add(u32* id, const char* name, const u64 delta);
+BEDROCK_FUNCTION void profile_trace_start(const u64 events_per_thread);
+BEDROCK_FUNCTION void profile_snapshot(BedrockProfileSnapshot* snapshot);
+BEDROCK_FUNCTION int profile_dump(FILE* file);
+BEDROCK_FUNCTION int profile_write_chrome_trace(const char* path);
+BEDROCK_FUNCTION void profile_deinit(void);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_INLINE_FUNCTION u64 profile_clock_ns(void) {
+	struct timespec ts = {0};
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64) ts.tv_sec * 1000000000ULL + (u64) ts.tv_nsec;
+}
+
+// The first registration pins the ticks and the clock together, so that ticks can later be
+// converted to nanoseconds from the elapsed time alone.
+BEDROCK_INLINE_FUNCTION void profile_epoch_init(void) {
+	u32 state = 0;
+	if (__atomic_load_n(&(bedrock_profile.epoch_state), __ATOMIC_ACQUIRE)) return;
+	if (!__atomic_compare_exchange_n(&(bedrock_profile.epoch_state), &state, 1, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) return;
+	bedrock_profile.epoch_ns = profile_clock_ns();
+	bedrock_profile.epoch_ticks = PROFILE_TICKS();
+	__atomic_store_n(&(bedrock_profile.epoch_state), 2, __ATOMIC_RELEASE);
+	return;
+}
+
+BEDROCK_FUNCTION u32 profile_register(u32* id, const char** names, u32* names_cnt, const u32 max_cnt, const char* name) {
+	profile_epoch_init();
+
+	u32 expected = PROFILE_UNREGISTERED;
+	const u32 index = __atomic_fetch_add(names_cnt, 1, __ATOMIC_RELAXED);
+	if (index >= max_cnt) {
+		if (__atomic_compare_exchange_n(id, &expected, PROFILE_DISABLED, FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			BEDROCK_WARNING_LOG("Too many profiling zones or counters, '%s' will not be tracked.", name);
+		}
+		return __atomic_load_n(id, __ATOMIC_RELAXED);
+	}
+
+	__atomic_store_n(names + index, name, __ATOMIC_RELEASE);
+	if (__atomic_compare_exchange_n(id, &expected, index, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return index;
+
+	// Another thread registered the same call site first, leave this slot unnamed so reports skip it
+	__atomic_store_n(names + index, NULL, __ATOMIC_RELAXED);
+
+	return expected;
+}
+
+BEDROCK_FUNCTION BedrockProfileThread* profile_register_thread(void) {
+	bedrock_profile_local.failed = TRUE;
+
+	const u32 index = __atomic_fetch_add(&(bedrock_profile.threads_cnt), 1, __ATOMIC_RELAXED);
+	if (index >= PROFILE_MAX_THREADS) {
+		BEDROCK_WARNING_LOG("Too many profiled threads, the current one will not be tracked.");
+		return NULL;
+	}
+
+	BedrockProfileThread* thread = (BedrockProfileThread*) bedrock_calloc(1, sizeof(BedrockProfileThread));
+	if (thread == NULL) {
+		BEDROCK_WARNING_LOG("Failed to allocate the profiling block of thread %u.", index + 1);
+		return NULL;
+	}
+
+	thread -> tid = index + 1;
+	__atomic_store_n(bedrock_profile.threads + index, thread, __ATOMIC_RELEASE);
+	bedrock_profile_local.failed = FALSE;
+	bedrock_profile_local.thread = thread;
+
+	return thread;
+}
+
+BEDROCK_INLINE_FUNCTION BedrockProfileThread* profile_current_thread(void) {
+	const u32 generation = __atomic_load_n(&(bedrock_profile.generation), __ATOMIC_ACQUIRE);
+	if (bedrock_profile_local.generation != generation) {
+		// The block was released by profile_deinit, register a fresh one
+		bedrock_profile_local.thread = NULL;
+		bedrock_profile_local.failed = FALSE;
+		bedrock_profile_local.trace_failed = FALSE;
+		bedrock_profile_local.generation = generation;
+	}
+	if (bedrock_profile_local.thread != NULL || bedrock_profile_local.failed) return bedrock_profile_local.thread;
+	return profile_register_thread();
+}
+
+BEDROCK_FUNCTION void profile_trace_alloc(BedrockProfileThread* thread, const u64 capacity) {
+	thread -> events = (BedrockProfileEvent*) bedrock_calloc(capacity, sizeof(BedrockProfileEvent));
+	if (thread -> events == NULL) {
+		BEDROCK_WARNING_LOG("Failed to allocate %llu trace events for thread %u.", capacity, thread -> tid);
+		bedrock_profile_local.trace_failed = TRUE;
+		return;
+	}
+	thread -> events_capacity = capacity;
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION u64 profile_zone_begin(u32* id, const char* name) {
+	if (__atomic_load_n(id, __ATOMIC_ACQUIRE) == PROFILE_UNREGISTERED) {
+		profile_register(id, bedrock_profile.zones, &(bedrock_profile.zones_cnt), PROFILE_MAX_ZONES, name);
+	}
+	return PROFILE_TICKS();
+}
+
+BEDROCK_INLINE_FUNCTION void profile_zone_end(const u32* id, const u64 start) {
+	const u64 end = PROFILE_TICKS();
+	const u32 zone = __atomic_load_n(id, __ATOMIC_RELAXED);
+	if (zone >= PROFILE_MAX_ZONES) return;
+
+	BedrockProfileThread* thread = profile_current_thread();
+	if (thread == NULL) return;
+
+	// NOTE: The tick counters of different cores may be slightly apart after a migration
+	const u64 ticks = (end > start) ? end - start : 0;
+	BedrockProfileStats* stats = thread -> zones + zone;
+	const u64 count = stats -> count;
+	PROFILE_STORE(&(stats -> count), count + 1);
+	PROFILE_STORE(&(stats -> total), stats -> total + ticks);
+	if (count == 0 || ticks < stats -> min) PROFILE_STORE(&(stats -> min), ticks);
+	if (ticks > stats -> max) PROFILE_STORE(&(stats -> max), ticks);
+	const u8 bucket = ticks ? (u8) (63 - __builtin_clzll(ticks)) : 0;
+	PROFILE_STORE(stats -> histogram + bucket, stats -> histogram[bucket] + 1);
+
+	const u64 trace_capacity = PROFILE_LOAD(&(bedrock_profile.trace_capacity));
+	if (trace_capacity == 0) return;
+	// NOTE: A failed allocation is not retried, the events of the thread are only counted as dropped
+	if (thread -> events == NULL && !bedrock_profile_local.trace_failed) profile_trace_alloc(thread, trace_capacity);
+
+	const u64 events_cnt = thread -> events_cnt;
+	if (events_cnt >= thread -> events_capacity) {
+		PROFILE_STORE(&(thread -> dropped_events), thread -> dropped_events + 1);
+		return;
+	}
+
+	thread -> events[events_cnt] = (BedrockProfileEvent) { .start = start, .end = end, .zone = zone };
+	__atomic_store_n(&(thread -> events_cnt), events_cnt + 1, __ATOMIC_RELEASE);
+
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void profile_counter_add(u32* id, const char* name, const u64 delta) {
+	u32 counter = __atomic_load_n(id, __ATOMIC_ACQUIRE);
+	if (counter == PROFILE_UNREGISTERED) {
+		counter = profile_register(id, bedrock_profile.counters, &(bedrock_profile.counters_cnt), PROFILE_MAX_COUNTERS, name);
+	}
+	if (counter >= PROFILE_MAX_COUNTERS) return;
+
+	BedrockProfileThread* thread = profile_current_thread();
+	if (thread == NULL) return;
+	PROFILE_STORE(thread -> counters + counter, thread -> counters[counter] + delta);
+
+	return;
+}
+
+/// Every thread records up to events_per_thread zones from now on, the later ones are dropped.
+BEDROCK_FUNCTION void profile_trace_start(const u64 events_per_thread) {
+	PROFILE_STORE(&(bedrock_profile.trace_capacity), events_per_thread);
+	return;
+}
+
+BEDROCK_FUNCTION double profile_ticks_per_ns(void) {
+	if (__atomic_load_n(&(bedrock_profile.epoch_state), __ATOMIC_ACQUIRE) != 2) return 1.0;
+	const u64 elapsed_ticks = PROFILE_TICKS() - bedrock_profile.epoch_ticks;
+	const u64 elapsed_ns = profile_clock_ns() - bedrock_profile.epoch_ns;
+	if (elapsed_ns == 0 || elapsed_ticks == 0) return 1.0;
+	return (double) elapsed_ticks / (double) elapsed_ns;
+}
+
+/// Merges the blocks of all the threads, while they may still be recording.
+BEDROCK_FUNCTION void profile_snapshot(BedrockProfileSnapshot* snapshot) {
+	if (snapshot == NULL) return;
+	mem_set(snapshot, 0, sizeof(BedrockProfileSnapshot));
+
+	snapshot -> ticks_per_ns = profile_ticks_per_ns();
+	snapshot -> zones_cnt = MIN(PROFILE_LOAD(&(bedrock_profile.zones_cnt)), PROFILE_MAX_ZONES);
+	snapshot -> counters_cnt = MIN(PROFILE_LOAD(&(bedrock_profile.counters_cnt)), PROFILE_MAX_COUNTERS);
+	for (u32 i = 0; i < snapshot -> zones_cnt; ++i) snapshot -> zones[i].name = __atomic_load_n(bedrock_profile.zones + i, __ATOMIC_ACQUIRE);
+	for (u32 i = 0; i < snapshot -> counters_cnt; ++i) snapshot -> counters[i].name = __atomic_load_n(bedrock_profile.counters + i, __ATOMIC_ACQUIRE);
+
+	const u32 threads_cnt = MIN(PROFILE_LOAD(&(bedrock_profile.threads_cnt)), PROFILE_MAX_THREADS);
+	for (u32 t = 0; t < threads_cnt; ++t) {
+		const BedrockProfileThread* thread = __atomic_load_n(bedrock_profile.threads + t, __ATOMIC_ACQUIRE);
+		if (thread == NULL) continue;
+
+		for (u32 i = 0; i < snapshot -> zones_cnt; ++i) {
+			const BedrockProfileStats* stats = thread -> zones + i;
+			BedrockProfileStats* merged = &(snapshot -> zones[i].stats);
+			const u64 count = PROFILE_LOAD(&(stats -> count));
+			if (count == 0) continue;
+
+			const u64 min = PROFILE_LOAD(&(stats -> min));
+			if (merged -> count == 0 || min < merged -> min) merged -> min = min;
+			merged -> max = MAX(merged -> max, PROFILE_LOAD(&(stats -> max)));
+			merged -> count += count;
+			merged -> total += PROFILE_LOAD(&(stats -> total));
+			for (u8 b = 0; b < PROFILE_HISTOGRAM_BUCKETS; ++b) merged -> histogram[b] += PROFILE_LOAD(stats -> histogram + b);
+		}
+
+		for (u32 i = 0; i < snapshot -> counters_cnt; ++i) snapshot -> counters[i].value += PROFILE_LOAD(thread -> counters + i);
+	}
+
+	return;
+}
+
+// Upper bound of the histogram bucket holding the given quantile of the durations
+BEDROCK_INLINE_FUNCTION u64 profile_quantile(const BedrockProfileStats* stats, const double quantile) {
+	const u64 target = (u64) (quantile * (double) stats -> count);
+	u64 cumulative = 0;
+	for (u8 b = 0; b < PROFILE_HISTOGRAM_BUCKETS; ++b) {
+		cumulative += stats -> histogram[b];
+		if (cumulative > target) return MIN((b < 63) ? (2ULL << b) - 1 : ~0ULL, stats -> max);
+	}
+	return stats -> max;
+}
+
+/// Prints a table with a row per zone and per counter, the quantiles are bounded by the log2 histogram.
+BEDROCK_FUNCTION int profile_dump(FILE* file) {
+	if (file == NULL) return -1;
+
+	BedrockProfileSnapshot* snapshot = (BedrockProfileSnapshot*) bedrock_calloc(1, sizeof(BedrockProfileSnapshot));
+	if (snapshot == NULL) {
+		BEDROCK_WARNING_LOG("Failed to allocate the profiling snapshot.");
+		return -1;
+	}
+	profile_snapshot(snapshot);
+
+	const double ticks_per_ns = snapshot -> ticks_per_ns;
+	fprintf(file, "%-32s %12s %12s %12s %12s %12s %12s %12s\n", "zone", "count", "total_ms", "mean_ns", "min_ns", "p50_ns", "p99_ns", "max_ns");
+	for (u32 i = 0; i < snapshot -> zones_cnt; ++i) {
+		const BedrockProfileZoneReport* zone = snapshot -> zones + i;
+		const BedrockProfileStats* stats = &(zone -> stats);
+		if (zone -> name == NULL || stats -> count == 0) continue;
+		fprintf(file, "%-32s %12llu %12.3f %12.1f %12.1f %12.1f %12.1f %12.1f\n", zone -> name, stats -> count,
+				(double) stats -> total / ticks_per_ns / 1e6,
+				(double) stats -> total / ticks_per_ns / (double) stats -> count,
+				(double) stats -> min / ticks_per_ns,
+				(double) profile_quantile(stats, 0.50) / ticks_per_ns,
+				(double) profile_quantile(stats, 0.99) / ticks_per_ns,
+				(double) stats -> max / ticks_per_ns);
+	}
+
+	if (snapshot -> counters_cnt) fprintf(file, "\n%-32s %12s\n", "counter", "value");
+	for (u32 i = 0; i < snapshot -> counters_cnt; ++i) {
+		if (snapshot -> counters[i].name == NULL) continue;
+		fprintf(file, "%-32s %12llu\n", snapshot -> counters[i].name, snapshot -> counters[i].value);
+	}
+
+	bedrock_free(snapshot);
+
+	return 0;
+}
+
+BEDROCK_FUNCTION void profile_write_json_str(FILE* file, const char* str) {
+	fputc('"', file);
+	for (; *str; ++str) {
+		if (*str == '"' || *str == '\\') fputc('\\', file), fputc(*str, file);
+		else if ((u8) *str < 0x20) fprintf(file, "\\u%04x", (u8) *str);
+		else fputc(*str, file);
+	}
+	fputc('"', file);
+	return;
+}
+
+/// Writes the recorded zones as Chrome trace complete events, and the counters totals at the end.
+BEDROCK_FUNCTION int profile_write_chrome_trace(const char* path) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		BEDROCK_WARNING_LOG("Failed to open the trace file '%s'.", path);
+		return -1;
+	}
+
+	const double ticks_per_us = profile_ticks_per_ns() * 1e3;
+	const u64 epoch_ticks = bedrock_profile.epoch_ticks;
+	const u32 zones_cnt = MIN(PROFILE_LOAD(&(bedrock_profile.zones_cnt)), PROFILE_MAX_ZONES);
+	u64 last_end = epoch_ticks;
+	bool is_first = TRUE;
+
+	fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+	const u32 threads_cnt = MIN(PROFILE_LOAD(&(bedrock_profile.threads_cnt)), PROFILE_MAX_THREADS);
+	for (u32 t = 0; t < threads_cnt; ++t) {
+		const BedrockProfileThread* thread = __atomic_load_n(bedrock_profile.threads + t, __ATOMIC_ACQUIRE);
+		if (thread == NULL) continue;
+
+		const u64 events_cnt = __atomic_load_n(&(thread -> events_cnt), __ATOMIC_ACQUIRE);
+		for (u64 i = 0; i < events_cnt; ++i) {
+			const BedrockProfileEvent* event = thread -> events + i;
+			const char* name = (event -> zone < zones_cnt) ? __atomic_load_n(bedrock_profile.zones + event -> zone, __ATOMIC_ACQUIRE) : NULL;
+			if (name == NULL) name = "unknown";
+			const u64 start = (event -> start > epoch_ticks) ? event -> start - epoch_ticks : 0;
+			last_end = MAX(last_end, event -> end);
+
+			fprintf(file, "%s\n  {\"name\": ", is_first ? "" : ",");
+			profile_write_json_str(file, name);
+			fprintf(file, ", \"cat\": \"bedrock\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+					thread -> tid, (double) start / ticks_per_us, (double) (event -> end - event -> start) / ticks_per_us);
+			is_first = FALSE;
+		}
+
+		const u64 dropped_events = PROFILE_LOAD(&(thread -> dropped_events));
+		if (dropped_events) BEDROCK_WARNING_LOG("Thread %u dropped %llu trace events, as its buffer was full.", thread -> tid, dropped_events);
+	}
+
+	BedrockProfileSnapshot* snapshot = (BedrockProfileSnapshot*) bedrock_calloc(1, sizeof(BedrockProfileSnapshot));
+	if (snapshot != NULL) {
+		profile_snapshot(snapshot);
+		for (u32 i = 0; i < snapshot -> counters_cnt; ++i) {
+			if (snapshot -> counters[i].name == NULL) continue;
+			fprintf(file, "%s\n  {\"name\": ", is_first ? "" : ",");
+			profile_write_json_str(file, snapshot -> counters[i].name);
+			fprintf(file, ", \"ph\": \"C\", \"pid\": 1, \"ts\": %.3f, \"args\": {\"value\": %llu}}",
+					(double) (last_end - epoch_ticks) / ticks_per_us, snapshot -> counters[i].value);
+			is_first = FALSE;
+		}
+		bedrock_free(snapshot);
+	} else BEDROCK_WARNING_LOG("Failed to allocate the profiling snapshot, the counters are not traced.");
+
+	fprintf(file, "\n]}\n");
+	fclose(file);
+
+	return 0;
+}
+
+/// Releases the blocks of all the threads, which register a new one if they record again afterwards.
+// NOTE: It must not run concurrently with the recording of other threads, as their blocks are freed under them.
+BEDROCK_FUNCTION void profile_deinit(void) {
+	const u32 threads_cnt = MIN(bedrock_profile.threads_cnt, PROFILE_MAX_THREADS);
+	for (u32 t = 0; t < threads_cnt; ++t) {
+		if (bedrock_profile.threads[t] == NULL) continue;
+		bedrock_free(bedrock_profile.threads[t] -> events);
+		bedrock_free(bedrock_profile.threads[t]);
+		bedrock_profile.threads[t] = NULL;
+	}
+	bedrock_profile.threads_cnt = 0;
+	bedrock_profile.trace_capacity = 0;
+	__atomic_add_fetch(&(bedrock_profile.generation), 1, __ATOMIC_RELEASE);
+	return;
+}
+
+#endif //_BEDROCK_PROFILE_H_
@@ -0,0 +1,265 @@
+#ifndef _BEDROCK_QUEUE_H_
+#define _BEDROCK_QUEUE_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Lock-Free Ring Queues
+// -----------------------
+// Both queues rely on the GCC __atomic builtins rather than <stdatomic.h>, so that the same code
+// builds in kernel space. The indices are free-running u64 counters masked on access, hence the
+// capacity is always rounded up to a power of two and the indices never need to wrap.
+//
+// Usage:
+//   BEDROCK_SPSC_QUEUE(MsgQueue, Msg)  /* Defines MsgQueue and MsgQueue_init, MsgQueue_push, ... */
+//   BEDROCK_MPMC_QUEUE(JobQueue, Job)
+//
+// NOTE: head and tail only sit on their own cache lines if the queue itself is cache line aligned,
+//       which static and stack queues are, but malloc only guarantees 16 bytes: heap queues should
+//       be allocated through name##_create/name##_destroy rather than embedded in a plain allocation.
+#ifndef BEDROCK_CACHE_LINE
+#	define BEDROCK_CACHE_LINE 64
+#endif // BEDROCK_CACHE_LINE
+
+#define BEDROCK_CACHE_ALIGNED __attribute__((aligned(BEDROCK_CACHE_LINE)))
+
+#if defined(__x86_64__) || defined(__i386__)
+#	define BEDROCK_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#	define BEDROCK_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#	define BEDROCK_CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+#endif // BEDROCK_CPU_RELAX
+
+#define BEDROCK_ATOMIC_LOAD(ptr, order)                      __atomic_load_n(ptr, order)
+#define BEDROCK_ATOMIC_STORE(ptr, val, order)                __atomic_store_n(ptr, val, order)
+#define BEDROCK_ATOMIC_CAS_WEAK(ptr, expected, desired, ord) __atomic_compare_exchange_n(ptr, expected, desired, TRUE, ord, __ATOMIC_RELAXED)
+
+BEDROCK_INLINE_FUNCTION u64 queue_capacity(const u64 capacity) {
+	u64 pow_capacity = 2;
+	while (pow_capacity < capacity) pow_capacity <<= 1;
+	return pow_capacity;
+}
+
+// Cache line aligned allocation on top of bedrock_calloc: the original pointer is stashed right
+// before the aligned block, so that custom (or kernel) allocators keep working.
+BEDROCK_INLINE_FUNCTION void* queue_aligned_alloc(const u64 size) {
+	u8* raw = (u8*) bedrock_calloc(size + BEDROCK_CACHE_LINE + sizeof(void*), sizeof(u8));
+	if (raw == NULL) return NULL;
+	const __UINTPTR_TYPE__ addr = (__UINTPTR_TYPE__) (raw + sizeof(void*));
+	u8* aligned = raw + sizeof(void*) + ((BEDROCK_CACHE_LINE - addr % BEDROCK_CACHE_LINE) % BEDROCK_CACHE_LINE);
+	__builtin_memcpy(aligned - sizeof(void*), &raw, sizeof(void*));
+	return aligned;
+}
+
+BEDROCK_INLINE_FUNCTION void queue_aligned_free(void* ptr) {
+	if (ptr == NULL) return;
+	void* raw = NULL;
+	__builtin_memcpy(&raw, CAST_PTR(ptr, u8) - sizeof(void*), sizeof(void*));
+	bedrock_free(raw);
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// --------------------------------------
+//  Single Producer Single Consumer Ring
+// --------------------------------------
+// Each side caches the last seen index of the other one, so the shared cache line is only
+// touched when the ring looks full (producer) or empty (consumer).
+#define BEDROCK_SPSC_QUEUE(name, type)                                                                   \
+	typedef struct name {                                                                                \
+		type* buffer;                                                                                    \
+		u64 mask;                                                                                        \
+		BEDROCK_CACHE_ALIGNED u64 head;                                                                  \
+		u64 cached_tail;                                                                                 \
+		BEDROCK_CACHE_ALIGNED u64 tail;                                                                  \
+		u64 cached_head;                                                                                 \
+	} name;                                                                                              \
+                                                                                                         \
+	BEDROCK_FUNCTION int name##_init(name* queue, const u64 capacity) {                                  \
+		if (queue == NULL) return -1;                                                                    \
+		const u64 pow_capacity = queue_capacity(capacity);                                               \
+		queue -> buffer = (type*) bedrock_calloc(pow_capacity, sizeof(type));                            \
+		if (queue -> buffer == NULL) {                                                                   \
+			BEDROCK_WARNING_LOG("Failed to allocate the buffer of the queue '" #name "'.");              \
+			return -1;                                                                                   \
+		}                                                                                                \
+		queue -> mask = pow_capacity - 1;                                                                \
+		queue -> head = queue -> cached_tail = 0;                                                        \
+		queue -> tail = queue -> cached_head = 0;                                                        \
+		return 0;                                                                                        \
+	}                                                                                                    \
+                                                                                                         \
+	BEDROCK_FUNCTION void name##_deinit(name* queue) {                                                   \
+		if (queue == NULL) return;                                                                       \
+		bedrock_free(queue -> buffer);                                                                   \
+		queue -> buffer = NULL;                                                                          \
+		return;                                                                                          \
+	}                                                                                                    \
+                                                                                                         \
+	/* Heap allocated queue, cache line aligned unlike a plain bedrock_calloc */                         \
+	BEDROCK_FUNCTION name* name##_create(const u64 capacity) {                                           \
+		name* queue = (name*) queue_aligned_alloc(sizeof(name));                                         \
+		if (queue == NULL) {                                                                             \
+			BEDROCK_WARNING_LOG("Failed to allocate the queue '" #name "'.");                            \
+			return NULL;                                                                                 \
+		}                                                                                                \
+		if (name##_init(queue, capacity)) {                                                              \
+			queue_aligned_free(queue);                                                                   \
+			return NULL;                                                                                 \
+		}                                                                                                \
+		return queue;                                                                                    \
+	}                                                                                                    \
+                                                                                                         \
+	BEDROCK_FUNCTION void name##_destroy(name* queue) {                                                  \
+		name##_deinit(queue);                                                                            \
+		queue_aligned_free(queue);                                                                       \
+		return;                                                                                          \
+	}                                                                                                    \
+                                                                                                         \
+	BEDROCK_INLINE_FUNCTION bool name##_push(name* queue, const type val) {                              \
+		const u64 tail = BEDROCK_ATOMIC_LOAD(&(queue -> tail), __ATOMIC_RELAXED);                        \
+		if (tail - queue -> cached_head > queue -> mask) {                                               \
+			queue -> cached_head = BEDROCK_ATOMIC_LOAD(&(queue -> head), __ATOMIC_ACQUIRE);              \
+			if (tail - queue -> cached_head > queue -> mask) return FALSE;                               \
+		}                                                                                                \
+		queue -> buffer[tail & queue -> mask] = val;                                                     \
+		BEDROCK_ATOMIC_STORE(&(queue -> tail), tail + 1, __ATOMIC_RELEASE);                              \
+		return TRUE;                                                                                     \
+	}                                                                                                    \
+                                                                                                         \
+	BEDROCK_INLINE_FUNCTION bool name##_pop(name* queue, type* val) {                                    \
+		const u64 head = BEDROCK_ATOMIC_LOAD(&(queue -> head), __ATOMIC_RELAXED);                        \
+		if (head == queue -> cached_tail) {                                                              \
+			queue -> cached_tail = BEDROCK_ATOMIC_LOAD(&(queue -> tail), __ATOMIC_ACQUIRE);              \
+			if (head == queue -> cached_tail) return FALSE;                                              \
+		}                                                                                                \
+		*val = queue -> buffer[head & queue -> mask];                                                    \
+		BEDROCK_ATOMIC_STORE(&(queue -> head), head + 1, __ATOMIC_RELEASE);                              \
+		return TRUE;                                                                                     \
+	}                                                                                                    \
+                                                                                                         \
+	/* Publishes up to cnt items with a single release store, returning how many were pushed */          \
+	BEDROCK_FUNCTION u64 name##_push_batch(name* queue, const type* vals, const u64 cnt) {               \
+		const u64 tail = BEDROCK_ATOMIC_LOAD(&(queue -> tail), __ATOMIC_RELAXED);                        \
+		u64 free_cnt = queue -> mask + 1 - (tail - queue -> cached_head);                                \
+		if (free_cnt < cnt) {                                                                            \
+			queue -> cached_head = BEDROCK_ATOMIC_LOAD(&(queue -> head), __ATOMIC_ACQUIRE);              \
+			free_cnt = queue -> mask + 1 - (tail - queue -> cached_head);                                \
+		}                                                                                                \
+		const u64 push_cnt = MIN(free_cnt, cnt);                                                         \
+		for (u64 i = 0; i < push_cnt; ++i) queue -> buffer[(tail + i) & queue -> mask] = vals[i];        \
+		if (push_cnt) BEDROCK_ATOMIC_STORE(&(queue -> tail), tail + push_cnt, __ATOMIC_RELEASE);         \
+		return push_cnt;                                                                                 \
+	}                                                                                                    \
+                                                                                                         \
+	/* Consumes up to max_cnt items with a single release store, returning how many were popped */       \
+	BEDROCK_FUNCTION u64 name##_pop_batch(name* queue, type* vals, const u64 max_cnt) {                  \
+		const u64 head = BEDROCK_ATOMIC_LOAD(&(queue -> head), __ATOMIC_RELAXED);                        \
+		u64 available = queue -> cached_tail - head;                                                     \
+		if (available < max_cnt) {                                                                       \
+			queue -> cached_tail = BEDROCK_ATOMIC_LOAD(&(queue -> tail), __ATOMIC_ACQUIRE);              \
+			available = queue -> cached_tail - head;                                                     \
+		}                                                                                                \
+		const u64 pop_cnt = MIN(available, max_cnt);                                                     \
+		for (u64 i = 0; i < pop_cnt; ++i) vals[i] = queue -> buffer[(head + i) & queue -> mask];         \
+		if (pop_cnt) BEDROCK_ATOMIC_STORE(&(queue -> head), head + pop_cnt, __ATOMIC_RELEASE);           \
+		return pop_cnt;                                                                                  \
+	}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ---------------------------------------
+//  Multi Producer Multi Consumer Queue
+// ---------------------------------------
+// Bounded queue with a sequence number per slot (Vyukov): a slot is writable when its sequence
+// equals the enqueue position and readable when it equals the dequeue position + 1, so producers
+// and consumers only contend on their own position counter.
+#define BEDROCK_MPMC_QUEUE(name, type)                                                                        \
+	typedef struct name##Cell {                                                                               \
+		u64 sequence;                                                                                         \
+		type data;                                                                                            \
+	} name##Cell;                                                                                             \
+                                                                                                              \
+	typedef struct name {                                                                                     \
+		name##Cell* buffer;                                                                                   \
+		u64 mask;                                                                                             \
+		BEDROCK_CACHE_ALIGNED u64 enqueue_pos;                                                                \
+		BEDROCK_CACHE_ALIGNED u64 dequeue_pos;                                                                \
+	} name;                                                                                                   \
+                                                                                                              \
+	BEDROCK_FUNCTION int name##_init(name* queue, const u64 capacity) {                                       \
+		if (queue == NULL) return -1;                                                                         \
+		const u64 pow_capacity = queue_capacity(capacity);                                                    \
+		queue -> buffer = (name##Cell*) bedrock_calloc(pow_capacity, sizeof(name##Cell));                     \
+		if (queue -> buffer == NULL) {                                                                        \
+			BEDROCK_WARNING_LOG("Failed to allocate the buffer of the queue '" #name "'.");                   \
+			return -1;                                                                                        \
+		}                                                                                                     \
+		for (u64 i = 0; i < pow_capacity; ++i) queue -> buffer[i].sequence = i;                               \
+		queue -> mask = pow_capacity - 1;                                                                     \
+		queue -> enqueue_pos = 0;                                                                             \
+		queue -> dequeue_pos = 0;                                                                             \
+		return 0;                                                                                             \
+	}                                                                                                         \
+                                                                                                              \
+	BEDROCK_FUNCTION void name##_deinit(name* queue) {                                                        \
+		if (queue == NULL) return;                                                                            \
+		bedrock_free(queue -> buffer);                                                                        \
+		queue -> buffer = NULL;                                                                               \
+		return;                                                                                               \
+	}                                                                                                         \
+                                                                                                              \
+	/* Heap allocated queue, cache line aligned unlike a plain bedrock_calloc */                              \
+	BEDROCK_FUNCTION name* name##_create(const u64 capacity) {                                                \
+		name* queue = (name*) queue_aligned_alloc(sizeof(name));                                              \
+		if (queue == NULL) {                                                                                  \
+			BEDROCK_WARNING_LOG("Failed to allocate the queue '" #name "'.");                                 \
+			return NULL;                                                                                      \
+		}                                                                                                     \
+		if (name##_init(queue, capacity)) {                                                                   \
+			queue_aligned_free(queue);                                                                        \
+			return NULL;                                                                                      \
+		}                                                                                                     \
+		return queue;                                                                                         \
+	}                                                                                                         \
+                                                                                                              \
+	BEDROCK_FUNCTION void name##_destroy(name* queue) {                                                       \
+		name##_deinit(queue);                                                                                 \
+		queue_aligned_free(queue);                                                                            \
+		return;                                                                                               \
+	}                                                                                                         \
+                                                                                                              \
+	BEDROCK_INLINE_FUNCTION bool name##_push(name* queue, const type val) {                                   \
+		u64 pos = BEDROCK_ATOMIC_LOAD(&(queue -> enqueue_pos), __ATOMIC_RELAXED);                             \
+		name##Cell* cell = NULL;                                                                              \
+		while (TRUE) {                                                                                        \
+			cell = queue -> buffer + (pos & queue -> mask);                                                   \
+			const s64 diff = (s64) (BEDROCK_ATOMIC_LOAD(&(cell -> sequence), __ATOMIC_ACQUIRE) - pos);        \
+			if (diff == 0) {                                                                                  \
+				if (BEDROCK_ATOMIC_CAS_WEAK(&(queue -> enqueue_pos), &pos, pos + 1, __ATOMIC_RELAXED)) break; \
+			} else if (diff < 0) {                                                                            \
+				return FALSE;                                                                                 \
+			} else pos = BEDROCK_ATOMIC_LOAD(&(queue -> enqueue_pos), __ATOMIC_RELAXED);                      \
+		}                                                                                                     \
+		cell -> data = val;                                                                                   \
+		BEDROCK_ATOMIC_STORE(&(cell -> sequence), pos + 1, __ATOMIC_RELEASE);                                 \
+		return TRUE;                                                                                          \
+	}                                                                                                         \
+                                                                                                              \
+	BEDROCK_INLINE_FUNCTION bool name##_pop(name* queue, type* val) {                                         \
+		u64 pos = BEDROCK_ATOMIC_LOAD(&(queue -> dequeue_pos), __ATOMIC_RELAXED);                             \
+		name##Cell* cell = NULL;                                                                              \
+		while (TRUE) {                                                                                        \
+			cell = queue -> buffer + (pos & queue -> mask);                                                   \
+			const s64 diff = (s64) (BEDROCK_ATOMIC_LOAD(&(cell -> sequence), __ATOMIC_ACQUIRE) - (pos + 1));  \
+			if (diff == 0) {                                                                                  \
+				if (BEDROCK_ATOMIC_CAS_WEAK(&(queue -> dequeue_pos), &pos, pos + 1, __ATOMIC_RELAXED)) break; \
+			} else if (diff < 0) {                                                                            \
+				return FALSE;                                                                                 \
+			} else pos = BEDROCK_ATOMIC_LOAD(&(queue -> dequeue_pos), __ATOMIC_RELAXED);                      \
+		}                                                                                                     \
+		*val = cell -> data;                                                                                  \
+		BEDROCK_ATOMIC_STORE(&(cell -> sequence), pos + queue -> mask + 1, __ATOMIC_RELEASE);                 \
+		return TRUE;                                                                                          \
+	}
+
+#endif //_BEDROCK_QUEUE_H_
@@ -0,0 +1,343 @@
+#ifndef _BEDROCK_SORT_H_
+#define _BEDROCK_SORT_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ---------
+//  Sorting
+// ---------
+// - radix_sort_*: LSD radix sort on bytes, the histograms of every digit are built in a single
+//   pass and the digits shared by all the keys are skipped.
+// - str_sort: multikey quicksort (Bentley-Sedgewick) on the unsigned bytes, which never compares
+//   the same prefix twice.
+// - BEDROCK_SORT_DEFINE: pattern-defeating introsort (pdqsort) with the comparator inlined.
+#define SORT_INSERTION_THRESHOLD     24
+#define SORT_NINTHER_THRESHOLD       128
+#define SORT_PARTIAL_INSERTION_LIMIT 8
+#define RADIX_SORT_THRESHOLD         64
+#define RADIX_BITS                   8
+#define RADIX_BUCKETS                (1 << RADIX_BITS)
+
+#define BEDROCK_SORT_LESS(a, b) ((a) < (b))
+#define SORT_SWAP(type, a, b) do { type __tmp = (a); (a) = (b); (b) = __tmp; } while (0)
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ----------------------
+//  Generic Introsort
+// ----------------------
+// BEDROCK_SORT_DEFINE(sort_f64, double, BEDROCK_SORT_LESS) defines void sort_f64(double* arr, const u64 len),
+// where less(a, b) is any expression or function-like macro defining a strict weak ordering.
+#define BEDROCK_SORT_DEFINE(name, type, less)                                                                  \
+	BEDROCK_INLINE_FUNCTION void name##_insertion_sort(type* arr, const u64 len) {                             \
+		for (u64 i = 1; i < len; ++i) {                                                                        \
+			type val = arr[i];                                                                                 \
+			u64 j = i;                                                                                         \
+			for (; j > 0 && less(val, arr[j - 1]); --j) arr[j] = arr[j - 1];                                   \
+			arr[j] = val;                                                                                      \
+		}                                                                                                      \
+		return;                                                                                                \
+	}                                                                                                          \
+                                                                                                               \
+	/* Gives up after SORT_PARTIAL_INSERTION_LIMIT moves, telling whether the range ended up sorted */         \
+	BEDROCK_INLINE_FUNCTION bool name##_partial_insertion_sort(type* arr, const u64 len) {                     \
+		u64 moves = 0;                                                                                         \
+		for (u64 i = 1; i < len; ++i) {                                                                        \
+			if (!less(arr[i], arr[i - 1])) continue;                                                           \
+			type val = arr[i];                                                                                 \
+			u64 j = i;                                                                                         \
+			for (; j > 0 && less(val, arr[j - 1]); --j) arr[j] = arr[j - 1];                                   \
+			arr[j] = val;                                                                                      \
+			moves += i - j;                                                                                    \
+			if (moves > SORT_PARTIAL_INSERTION_LIMIT) return FALSE;                                            \
+		}                                                                                                      \
+		return TRUE;                                                                                           \
+	}                                                                                                          \
+                                                                                                               \
+	BEDROCK_INLINE_FUNCTION void name##_sift_down(type* arr, u64 root, const u64 len) {                        \
+		type val = arr[root];                                                                                  \
+		for (u64 child = 2 * root + 1; child < len; child = 2 * root + 1) {                                    \
+			if (child + 1 < len && less(arr[child], arr[child + 1])) ++child;                                  \
+			if (!less(val, arr[child])) break;                                                                 \
+			arr[root] = arr[child];                                                                            \
+			root = child;                                                                                      \
+		}                                                                                                      \
+		arr[root] = val;                                                                                       \
+		return;                                                                                                \
+	}                                                                                                          \
+                                                                                                               \
+	BEDROCK_FUNCTION void name##_heap_sort(type* arr, const u64 len) {                                         \
+		for (u64 i = len / 2; i > 0; --i) name##_sift_down(arr, i - 1, len);                                   \
+		for (u64 i = len; i > 1; --i) {                                                                        \
+			SORT_SWAP(type, arr[0], arr[i - 1]);                                                               \
+			name##_sift_down(arr, 0, i - 1);                                                                   \
+		}                                                                                                      \
+		return;                                                                                                \
+	}                                                                                                          \
+                                                                                                               \
+	BEDROCK_INLINE_FUNCTION void name##_sort3(type* arr, const u64 a, const u64 b, const u64 c) {              \
+		if (less(arr[b], arr[a])) SORT_SWAP(type, arr[a], arr[b]);                                             \
+		if (less(arr[c], arr[b])) SORT_SWAP(type, arr[b], arr[c]);                                             \
+		if (less(arr[b], arr[a])) SORT_SWAP(type, arr[a], arr[b]);                                             \
+		return;                                                                                                \
+	}                                                                                                          \
+                                                                                                               \
+	/* Moves the elements less than arr[0] to its left, returning the final pivot position */                  \
+	BEDROCK_INLINE_FUNCTION u64 name##_partition_right(type* arr, const u64 len, bool* already_partitioned) {  \
+		type pivot = arr[0];                                                                                   \
+		u64 first = 0;                                                                                         \
+		u64 last = len;                                                                                        \
+		while (less(arr[++first], pivot));                                                                     \
+		if (first == 1) while (first < last && !less(arr[--last], pivot));                                     \
+		else while (!less(arr[--last], pivot));                                                                \
+		*already_partitioned = first >= last;                                                                  \
+		while (first < last) {                                                                                 \
+			SORT_SWAP(type, arr[first], arr[last]);                                                            \
+			while (less(arr[++first], pivot));                                                                 \
+			while (!less(arr[--last], pivot));                                                                 \
+		}                                                                                                      \
+		arr[0] = arr[first - 1];                                                                               \
+		arr[first - 1] = pivot;                                                                                \
+		return first - 1;                                                                                      \
+	}                                                                                                          \
+                                                                                                               \
+	/* Moves the elements equal to arr[0] to its left, used when the predecessor equals the pivot */           \
+	BEDROCK_INLINE_FUNCTION u64 name##_partition_left(type* arr, const u64 len) {                              \
+		type pivot = arr[0];                                                                                   \
+		u64 first = 0;                                                                                         \
+		u64 last = len;                                                                                        \
+		while (less(pivot, arr[--last]));                                                                      \
+		if (last + 1 == len) while (first < last && !less(pivot, arr[++first]));                               \
+		else while (!less(pivot, arr[++first]));                                                               \
+		while (first < last) {                                                                                 \
+			SORT_SWAP(type, arr[first], arr[last]);                                                            \
+			while (less(pivot, arr[--last]));                                                                  \
+			while (!less(pivot, arr[++first]));                                                                \
+		}                                                                                                      \
+		arr[0] = arr[last];                                                                                    \
+		arr[last] = pivot;                                                                                     \
+		return last;                                                                                           \
+	}                                                                                                          \
+                                                                                                               \
+	BEDROCK_FUNCTION void name##_loop(type* arr, u64 len, u32 bad_allowed, bool leftmost) {                    \
+		while (len > SORT_INSERTION_THRESHOLD) {                                                               \
+			const u64 mid = len / 2;                                                                           \
+			if (len > SORT_NINTHER_THRESHOLD) {                                                                \
+				name##_sort3(arr, 0, mid, len - 1);                                                            \
+				name##_sort3(arr, 1, mid - 1, len - 2);                                                        \
+				name##_sort3(arr, 2, mid + 1, len - 3);                                                        \
+				name##_sort3(arr, mid - 1, mid, mid + 1);                                                      \
+				SORT_SWAP(type, arr[0], arr[mid]);                                                             \
+			} else name##_sort3(arr, mid, 0, len - 1);                                                         \
+                                                                                                               \
+			/* The predecessor is not greater than any element, so equal to the pivot means a run of equals */ \
+			if (!leftmost && !less(arr[-1], arr[0])) {                                                         \
+				const u64 pivot_pos = name##_partition_left(arr, len);                                         \
+				arr += pivot_pos + 1, len -= pivot_pos + 1;                                                    \
+				continue;                                                                                      \
+			}                                                                                                  \
+                                                                                                               \
+			bool already_partitioned = FALSE;                                                                  \
+			const u64 pivot_pos = name##_partition_right(arr, len, &already_partitioned);                      \
+			const u64 left_len = pivot_pos;                                                                    \
+			const u64 right_len = len - pivot_pos - 1;                                                         \
+                                                                                                               \
+			if (left_len < len / 8 || right_len < len / 8) {                                                   \
+				if (--bad_allowed == 0) {                                                                      \
+					name##_heap_sort(arr, len);                                                                \
+					return;                                                                                    \
+				}                                                                                              \
+				/* Break the patterns which led to the unbalanced partition */                                 \
+				if (left_len >= SORT_INSERTION_THRESHOLD) {                                                    \
+					SORT_SWAP(type, arr[0], arr[left_len / 4]);                                                \
+					SORT_SWAP(type, arr[pivot_pos - 1], arr[pivot_pos - left_len / 4]);                        \
+				}                                                                                              \
+				if (right_len >= SORT_INSERTION_THRESHOLD) {                                                   \
+					SORT_SWAP(type, arr[pivot_pos + 1], arr[pivot_pos + 1 + right_len / 4]);                   \
+					SORT_SWAP(type, arr[len - 1], arr[len - right_len / 4]);                                   \
+				}                                                                                              \
+			} else if (already_partitioned) {                                                                  \
+				if (name##_partial_insertion_sort(arr, left_len) &&                                            \
+					name##_partial_insertion_sort(arr + pivot_pos + 1, right_len)) return;                     \
+			}                                                                                                  \
+                                                                                                               \
+			/* Recurse into the smaller side, so that the stack depth stays logarithmic */                     \
+			if (left_len < right_len) {                                                                        \
+				name##_loop(arr, left_len, bad_allowed, leftmost);                                             \
+				arr += pivot_pos + 1, len = right_len, leftmost = FALSE;                                       \
+			} else {                                                                                           \
+				name##_loop(arr + pivot_pos + 1, right_len, bad_allowed, FALSE);                               \
+				len = left_len;                                                                                \
+			}                                                                                                  \
+		}                                                                                                      \
+		name##_insertion_sort(arr, len);                                                                       \
+		return;                                                                                                \
+	}                                                                                                          \
+                                                                                                               \
+	BEDROCK_FUNCTION void name(type* arr, const u64 len) {                                                     \
+		if (arr == NULL || len < 2) return;                                                                    \
+		u32 log_len = 0;                                                                                       \
+		for (u64 tmp = len; tmp > 1; tmp >>= 1) ++log_len;                                                     \
+		name##_loop(arr, len, log_len, TRUE);                                                                  \
+		return;                                                                                                \
+	}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ------------
+//  Radix Sort
+// ------------
+// Defines name(keys, payloads, len): payloads may be NULL, otherwise they are moved along with their keys.
+// flip is xored with each key before extracting the digits, the sign bit maps signed keys to unsigned order.
+#define BEDROCK_RADIX_SORT_DEFINE(name, key_type, payload_type, flip)                                           \
+	BEDROCK_FUNCTION int name(key_type* keys, payload_type* payloads, const u64 len) {                         \
+		if (keys == NULL || len < 2) return 0;                                                                 \
+                                                                                                               \
+		if (len < RADIX_SORT_THRESHOLD) {                                                                      \
+			for (u64 i = 1; i < len; ++i) {                                                                    \
+				const key_type key = keys[i];                                                                  \
+				payload_type payload = {0};                                                                    \
+				if (payloads != NULL) payload = payloads[i];                                                   \
+				u64 j = i;                                                                                     \
+				for (; j > 0 && (key_type) (keys[j - 1] ^ (flip)) > (key_type) (key ^ (flip)); --j) {          \
+					keys[j] = keys[j - 1];                                                                     \
+					if (payloads != NULL) payloads[j] = payloads[j - 1];                                       \
+				}                                                                                              \
+				keys[j] = key;                                                                                 \
+				if (payloads != NULL) payloads[j] = payload;                                                   \
+			}                                                                                                  \
+			return 0;                                                                                          \
+		}                                                                                                      \
+                                                                                                               \
+		key_type* tmp_keys = (key_type*) bedrock_calloc(len, sizeof(key_type));                                \
+		payload_type* tmp_payloads = NULL;                                                                     \
+		if (payloads != NULL) tmp_payloads = (payload_type*) bedrock_calloc(len, sizeof(payload_type));        \
+		if (tmp_keys == NULL || (payloads != NULL && tmp_payloads == NULL)) {                                  \
+			BEDROCK_WARNING_LOG("Failed to allocate the radix sort buffers of %llu elements.", len);           \
+			bedrock_free(tmp_keys);                                                                            \
+			bedrock_free(tmp_payloads);                                                                        \
+			return -1;                                                                                         \
+		}                                                                                                      \
+                                                                                                               \
+		u64 histograms[sizeof(key_type)][RADIX_BUCKETS] = {0};                                                 \
+		for (u64 i = 0; i < len; ++i) {                                                                        \
+			const key_type key = keys[i] ^ (flip);                                                             \
+			for (u8 digit = 0; digit < sizeof(key_type); ++digit) {                                            \
+				histograms[digit][(key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;                      \
+			}                                                                                                  \
+		}                                                                                                      \
+                                                                                                               \
+		key_type* src_keys = keys;                                                                             \
+		key_type* dest_keys = tmp_keys;                                                                        \
+		payload_type* src_payloads = payloads;                                                                 \
+		payload_type* dest_payloads = tmp_payloads;                                                            \
+		for (u8 digit = 0; digit < sizeof(key_type); ++digit) {                                                \
+			const u8 shift = digit * RADIX_BITS;                                                               \
+			u64* histogram = histograms[digit];                                                                \
+			/* All the keys share this digit, the pass would not move anything */                              \
+			if (histogram[((src_keys[0] ^ (flip)) >> shift) & (RADIX_BUCKETS - 1)] == len) continue;           \
+                                                                                                               \
+			u64 offset = 0;                                                                                    \
+			for (u64 bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {                                           \
+				const u64 cnt = histogram[bucket];                                                             \
+				histogram[bucket] = offset;                                                                    \
+				offset += cnt;                                                                                 \
+			}                                                                                                  \
+                                                                                                               \
+			for (u64 i = 0; i < len; ++i) {                                                                    \
+				const u64 pos = histogram[((src_keys[i] ^ (flip)) >> shift) & (RADIX_BUCKETS - 1)]++;          \
+				dest_keys[pos] = src_keys[i];                                                                  \
+				if (src_payloads != NULL) dest_payloads[pos] = src_payloads[i];                                \
+			}                                                                                                  \
+                                                                                                               \
+			SORT_SWAP(key_type*, src_keys, dest_keys);                                                         \
+			SORT_SWAP(payload_type*, src_payloads, dest_payloads);                                             \
+		}                                                                                                      \
+                                                                                                               \
+		if (src_keys != keys) {                                                                                \
+			mem_cpy(keys, src_keys, len * sizeof(key_type));                                                   \
+			if (payloads != NULL) mem_cpy(payloads, src_payloads, len * sizeof(payload_type));                 \
+		}                                                                                                      \
+                                                                                                               \
+		bedrock_free(tmp_keys);                                                                                \
+		bedrock_free(tmp_payloads);                                                                            \
+                                                                                                               \
+		return 0;                                                                                              \
+	}
+
+BEDROCK_RADIX_SORT_DEFINE(radix_sort_u32_kv, u32, u32, 0U)
+BEDROCK_RADIX_SORT_DEFINE(radix_sort_u64_kv, u64, u64, 0ULL)
+BEDROCK_RADIX_SORT_DEFINE(radix_sort_s64_raw_kv, u64, u64, 0x8000000000000000ULL)
+
+#define radix_sort_u32(keys, len)                 radix_sort_u32_kv(keys, NULL, len)
+#define radix_sort_u64(keys, len)                 radix_sort_u64_kv(keys, NULL, len)
+#define radix_sort_s64(keys, len)                 radix_sort_s64_raw_kv(CAST_PTR(keys, u64), NULL, len)
+#define radix_sort_s64_kv(keys, payloads, len)    radix_sort_s64_raw_kv(CAST_PTR(keys, u64), payloads, len)
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  String Arrays Sorting
+// -----------------------
+#define STR_SORT_CHR(str, depth) ((u8) (str)[depth])
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_FUNCTION void str_sort(char** str_arr, const u64 size);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+// Compares the suffixes starting at depth, as the shorter prefix is already known to be equal
+BEDROCK_INLINE_FUNCTION bool str_sort_less(const char* str1, const char* str2, const u64 depth) {
+	const u8* a = CAST_PTR(str1 + depth, u8);
+	const u8* b = CAST_PTR(str2 + depth, u8);
+	for (; *a && *a == *b; ++a, ++b);
+	return *a < *b;
+}
+
+BEDROCK_FUNCTION void str_sort_mkqs(char** str_arr, u64 size, u64 depth) {
+	while (size > SORT_INSERTION_THRESHOLD) {
+		const u8 a = STR_SORT_CHR(str_arr[0], depth);
+		const u8 b = STR_SORT_CHR(str_arr[size / 2], depth);
+		const u8 c = STR_SORT_CHR(str_arr[size - 1], depth);
+		const u8 pivot = (a < b) ? ((b < c) ? b : MAX(a, c)) : ((a < c) ? a : MAX(b, c));
+
+		// Three-way partition on the character at depth
+		u64 lt = 0;
+		u64 gt = size;
+		for (u64 i = 0; i < gt;) {
+			const u8 chr = STR_SORT_CHR(str_arr[i], depth);
+			if (chr < pivot) {
+				SORT_SWAP(char*, str_arr[lt], str_arr[i]);
+				++lt, ++i;
+			} else if (chr > pivot) {
+				--gt;
+				SORT_SWAP(char*, str_arr[i], str_arr[gt]);
+			} else ++i;
+		}
+
+		str_sort_mkqs(str_arr, lt, depth);
+		str_sort_mkqs(str_arr + gt, size - gt, depth);
+
+		// The equal strings share one more character, unless they all ended here
+		if (pivot == '\0') return;
+		str_arr += lt, size = gt - lt, ++depth;
+	}
+
+	for (u64 i = 1; i < size; ++i) {
+		char* str = str_arr[i];
+		u64 j = i;
+		for (; j > 0 && str_sort_less(str, str_arr[j - 1], depth); --j) str_arr[j] = str_arr[j - 1];
+		str_arr[j] = str;
+	}
+
+	return;
+}
+
+/// Sorts the strings by their unsigned bytes (as strcmp would), the array must not contain NULL entries.
+BEDROCK_FUNCTION void str_sort(char** str_arr, const u64 size) {
+	if (str_arr == NULL || size < 2) return;
+	str_sort_mkqs(str_arr, size, 0);
+	return;
+}
+
+#endif //_BEDROCK_SORT_H_
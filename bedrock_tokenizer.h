@@ -0,0 +1,444 @@
+#ifndef _BEDROCK_TOKENIZER_H_
+#define _BEDROCK_TOKENIZER_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ------------------------------------------
+//  Structural Tokenizer (CSV/TSV/key=value)
+// ------------------------------------------
+// The input is consumed in blocks of 64 bytes: each byte is classified into bitmasks
+// (delimiter, quote, escape, newline), the quoted regions are resolved with a prefix-xor
+// over the quote mask, and the surviving structural bits are flattened into field boundaries.
+// RFC 4180 doubled quotes need no special handling, as each pair toggles the quote state twice.
+#define TOK_BLOCK_SIZE          64
+#define TOK_INDEX_CAPACITY(len) ((len) + TOK_BLOCK_SIZE)
+#define TOK_EVEN_BITS           0x5555555555555555ULL
+#define TOK_ODD_BITS            (~TOK_EVEN_BITS)
+
+typedef struct BedrockField {
+	u64 offset;
+	u64 length;
+} BedrockField;
+
+typedef enum BedrockColumnType {
+	BEDROCK_COLUMN_FIELD,
+	BEDROCK_COLUMN_S64,
+	BEDROCK_COLUMN_U64
+} BedrockColumnType;
+
+typedef struct BedrockColumn {
+	BedrockColumnType type;
+	void* data; // BedrockField*, s64* or u64* with room for max_records entries
+} BedrockColumn;
+
+typedef struct BedrockTokenizer {
+	char delim;
+	char quote;       // '\0' disables quoting
+	char escape;      // '\0' leaves only RFC 4180 doubled quotes
+	char kv_sep;      // '\0' unless tokenizing key=value records
+	bool trim;        // strip the surrounding whitespaces from each field
+	u64 in_quote;     // all ones if the previous block ended inside a quoted field
+	u64 odd_escapes;  // 1 if the previous block ended with an odd run of escapes
+} BedrockTokenizer;
+
+typedef struct BedrockRecordIter {
+	const char* buf;
+	u64 len;
+	const u64* indices;
+	u64 indices_cnt;
+	u64 pos;
+	u64 start;
+} BedrockRecordIter;
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_FUNCTION void tok_init(BedrockTokenizer* tok, const char delim, const char quote, const char escape, const char kv_sep);
+BEDROCK_FUNCTION void tok_reset(BedrockTokenizer* tok);
+BEDROCK_INLINE_FUNCTION u64 tok_eq_mask(const u8* block, const u8 chr);
+BEDROCK_INLINE_FUNCTION u64 tok_prefix_xor(u64 bits);
+BEDROCK_INLINE_FUNCTION u64 tok_escaped_mask(BedrockTokenizer* tok, const u64 escapes);
+BEDROCK_INLINE_FUNCTION u64 tok_classify_block(BedrockTokenizer* tok, const u8* block);
+BEDROCK_FUNCTION u64 tok_index(BedrockTokenizer* tok, const char* buf, const u64 len, u64* indices);
+BEDROCK_FUNCTION void tok_record_iter(BedrockRecordIter* it, const char* buf, const u64 len, const u64* indices, const u64 indices_cnt);
+BEDROCK_FUNCTION s64 tok_next_record(const BedrockTokenizer* tok, BedrockRecordIter* it, BedrockField* fields, const u64 max_fields);
+BEDROCK_FUNCTION u64 tok_unquote(const BedrockTokenizer* tok, char* dest, const char* buf, const BedrockField field);
+BEDROCK_FUNCTION int tok_parse_u64(const char* str, const u64 len, u64* val);
+BEDROCK_FUNCTION int tok_parse_s64(const char* str, const u64 len, s64* val);
+BEDROCK_FUNCTION s64 tok_decode(BedrockTokenizer* tok, const char* buf, const u64 len, const BedrockColumn* columns, const u64 columns_cnt, const u64 max_records, u64* consumed);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_FUNCTION void tok_init(BedrockTokenizer* tok, const char delim, const char quote, const char escape, const char kv_sep) {
+	if (tok == NULL) return;
+	tok -> delim = delim;
+	tok -> quote = quote;
+	tok -> escape = escape;
+	tok -> kv_sep = kv_sep;
+	tok -> trim = FALSE;
+	tok_reset(tok);
+	return;
+}
+
+BEDROCK_FUNCTION void tok_reset(BedrockTokenizer* tok) {
+	if (tok == NULL) return;
+	tok -> in_quote = 0;
+	tok -> odd_escapes = 0;
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION u64 tok_eq_mask(const u8* block, const u8 chr) {
+	// NOTE: '\0' marks a disabled class and is also used to pad the last block
+	if (chr == '\0') return 0;
+#if defined(_BEDROCK_AVX2_)
+	const __m256i needle = _mm256_set1_epi8((char) chr);
+	const u64 lo = (u32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) block), needle));
+	const u64 hi = (u32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (block + 32)), needle));
+	return lo | (hi << 32);
+#elif defined(_BEDROCK_SSE2_)
+	const __m128i needle = _mm_set1_epi8((char) chr);
+	u64 mask = 0;
+	for (u8 i = 0; i < 4; ++i) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i*) (block + i * 16));
+		mask |= ((u64) (u16) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))) << (i * 16);
+	}
+	return mask;
+#else
+	u64 mask = 0;
+	for (u8 i = 0; i < TOK_BLOCK_SIZE; ++i) mask |= ((u64) (block[i] == chr)) << i;
+	return mask;
+#endif // _BEDROCK_AVX2_
+}
+
+BEDROCK_INLINE_FUNCTION u64 tok_prefix_xor(u64 bits) {
+#if defined(_BEDROCK_PCLMUL_)
+	const __m128i all_ones = _mm_set1_epi8(-1);
+	return (u64) _mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_set_epi64x(0, (long long) bits), all_ones, 0));
+#else
+	bits ^= bits << 1;
+	bits ^= bits << 2;
+	bits ^= bits << 4;
+	bits ^= bits << 8;
+	bits ^= bits << 16;
+	bits ^= bits << 32;
+	return bits;
+#endif // _BEDROCK_PCLMUL_
+}
+
+// Returns the mask of the bytes preceded by an odd-length run of escapes
+BEDROCK_INLINE_FUNCTION u64 tok_escaped_mask(BedrockTokenizer* tok, const u64 escapes) {
+	if (escapes == 0 && tok -> odd_escapes == 0) return 0;
+
+	const u64 start_edges = escapes & ~(escapes << 1);
+	const u64 even_start_mask = TOK_EVEN_BITS ^ tok -> odd_escapes;
+	const u64 even_starts = start_edges & even_start_mask;
+	const u64 odd_starts = start_edges & ~even_start_mask;
+	const u64 even_carries = escapes + even_starts;
+
+	u64 odd_carries = 0;
+	const bool ends_odd = __builtin_add_overflow(escapes, odd_starts, &odd_carries);
+	odd_carries |= tok -> odd_escapes;
+	tok -> odd_escapes = ends_odd;
+
+	const u64 even_start_odd_end = (even_carries & ~escapes) & TOK_ODD_BITS;
+	const u64 odd_start_even_end = (odd_carries & ~escapes) & TOK_EVEN_BITS;
+
+	return even_start_odd_end | odd_start_even_end;
+}
+
+BEDROCK_INLINE_FUNCTION u64 tok_classify_block(BedrockTokenizer* tok, const u8* block) {
+	const u64 escaped = tok_escaped_mask(tok, tok_eq_mask(block, tok -> escape));
+	const u64 quotes = tok_eq_mask(block, tok -> quote) & ~escaped;
+
+	const u64 in_quote = tok_prefix_xor(quotes) ^ tok -> in_quote;
+	tok -> in_quote = 0ULL - (in_quote >> 63);
+
+	const u64 structurals = tok_eq_mask(block, tok -> delim) | tok_eq_mask(block, tok -> kv_sep) | tok_eq_mask(block, '\n');
+
+	return structurals & ~in_quote & ~escaped;
+}
+
+/// Writes the offset of every delimiter and newline that is neither quoted nor escaped.
+/// NOTE: indices must hold at least TOK_INDEX_CAPACITY(len) entries, as the last entries are flattened in groups of four.
+/// NOTE: tok -> in_quote is left non-zero if the buffer ends inside a quoted field.
+BEDROCK_FUNCTION u64 tok_index(BedrockTokenizer* tok, const char* buf, const u64 len, u64* indices) {
+	if (tok == NULL || buf == NULL || indices == NULL) return 0;
+
+	u64* out = indices;
+	u8 tail[TOK_BLOCK_SIZE] = {0};
+	for (u64 base = 0; base < len; base += TOK_BLOCK_SIZE) {
+		const u8* block = CAST_PTR(buf + base, u8);
+		if (len - base < TOK_BLOCK_SIZE) {
+			__builtin_memcpy(tail, block, len - base);
+			block = tail;
+		}
+
+		u64 bits = tok_classify_block(tok, block);
+		u64* const next = out + __builtin_popcountll(bits);
+		while (out < next) {
+			out[0] = base + (bits ? (u64) __builtin_ctzll(bits) : 0), bits &= bits - 1;
+			out[1] = base + (bits ? (u64) __builtin_ctzll(bits) : 0), bits &= bits - 1;
+			out[2] = base + (bits ? (u64) __builtin_ctzll(bits) : 0), bits &= bits - 1;
+			out[3] = base + (bits ? (u64) __builtin_ctzll(bits) : 0), bits &= bits - 1;
+			out += 4;
+		}
+		out = next;
+	}
+
+	return (u64) (out - indices);
+}
+
+// Drops the trailing '\r' of a line and, when trimming, the surrounding whitespaces of the span
+BEDROCK_INLINE_FUNCTION void tok_trim_span(const BedrockTokenizer* tok, const char* buf, u64* start, u64* end, const bool is_eol) {
+	if (is_eol && *end > *start && buf[*end - 1] == '\r') --(*end);
+
+	if (tok -> trim) {
+		while (*start < *end && IS_WHITESPACE(buf[*start])) ++(*start);
+		while (*end > *start && IS_WHITESPACE(buf[*end - 1])) --(*end);
+	}
+
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION BedrockField tok_strip_quotes(const BedrockTokenizer* tok, const char* buf, u64 start, u64 end) {
+	if (tok -> quote && (end - start) >= 2 && buf[start] == tok -> quote && buf[end - 1] == tok -> quote) ++start, --end;
+	return (BedrockField) { .offset = start, .length = end - start };
+}
+
+BEDROCK_INLINE_FUNCTION BedrockField tok_make_field(const BedrockTokenizer* tok, const char* buf, u64 start, u64 end, const bool is_eol) {
+	tok_trim_span(tok, buf, &start, &end, is_eol);
+	return tok_strip_quotes(tok, buf, start, end);
+}
+
+// Closes the field ending at the boundary end, returning FALSE if the boundary only ends an empty line
+// NOTE: The emptiness is decided before stripping the quotes, so that a line holding only "" is still a record
+BEDROCK_INLINE_FUNCTION bool tok_boundary_field(const BedrockTokenizer* tok, const char* buf, u64* start, const u64 end, const bool is_eol, const u64 fields_cnt, BedrockField* field) {
+	u64 field_start = *start;
+	u64 field_end = end;
+	tok_trim_span(tok, buf, &field_start, &field_end, is_eol);
+	*start = end + 1;
+	if (is_eol && fields_cnt == 0 && field_start == field_end) return FALSE;
+	*field = tok_strip_quotes(tok, buf, field_start, field_end);
+	return TRUE;
+}
+
+// Closes the last field when the input does not end with a newline, returning FALSE if none is pending
+BEDROCK_INLINE_FUNCTION bool tok_tail_field(const BedrockTokenizer* tok, const char* buf, const u64 len, u64* start, const u64 fields_cnt, BedrockField* field) {
+	if (*start > len || (*start == len && fields_cnt == 0)) return FALSE;
+	*field = tok_make_field(tok, buf, *start, len, TRUE);
+	*start = len + 1;
+	return TRUE;
+}
+
+BEDROCK_FUNCTION void tok_record_iter(BedrockRecordIter* it, const char* buf, const u64 len, const u64* indices, const u64 indices_cnt) {
+	if (it == NULL) return;
+	it -> buf = buf;
+	it -> len = len;
+	it -> indices = indices;
+	it -> indices_cnt = indices_cnt;
+	it -> pos = 0;
+	it -> start = 0;
+	return;
+}
+
+/// Returns the number of fields of the next record, 0 once the input is exhausted,
+/// or -1 if the record did not fit in max_fields (the record is consumed anyway).
+BEDROCK_FUNCTION s64 tok_next_record(const BedrockTokenizer* tok, BedrockRecordIter* it, BedrockField* fields, const u64 max_fields) {
+	if (tok == NULL || it == NULL || fields == NULL) return -1;
+
+	u64 fields_cnt = 0;
+	bool is_eol = FALSE;
+	BedrockField field = {0};
+	while (!is_eol && it -> pos < it -> indices_cnt) {
+		const u64 end = it -> indices[(it -> pos)++];
+		is_eol = it -> buf[end] == '\n';
+
+		// Skip empty lines
+		if (!tok_boundary_field(tok, it -> buf, &(it -> start), end, is_eol, fields_cnt, &field)) {
+			is_eol = FALSE;
+			continue;
+		}
+
+		if (fields_cnt < max_fields) fields[fields_cnt] = field;
+		fields_cnt++;
+	}
+
+	// Last record without a trailing newline
+	if (!is_eol && tok_tail_field(tok, it -> buf, it -> len, &(it -> start), fields_cnt, &field)) {
+		if (fields_cnt < max_fields) fields[fields_cnt] = field;
+		fields_cnt++;
+	}
+
+	if (fields_cnt > max_fields) {
+		BEDROCK_WARNING_LOG("Record of %llu fields exceeds the maximum of %llu fields.", fields_cnt, max_fields);
+		return -1;
+	}
+
+	return fields_cnt;
+}
+
+/// Copies the field into dest (at least field.length + 1 bytes), collapsing doubled quotes and escapes.
+BEDROCK_FUNCTION u64 tok_unquote(const BedrockTokenizer* tok, char* dest, const char* buf, const BedrockField field) {
+	if (tok == NULL || dest == NULL || buf == NULL) return 0;
+
+	const char* src = buf + field.offset;
+	u64 len = 0;
+	for (u64 i = 0; i < field.length; ++i) {
+		if (tok -> escape && src[i] == tok -> escape && (i + 1) < field.length) ++i;
+		else if (tok -> quote && src[i] == tok -> quote && (i + 1) < field.length && src[i + 1] == tok -> quote) ++i;
+		dest[len++] = src[i];
+	}
+	dest[len] = '\0';
+
+	return len;
+}
+
+#ifdef _BEDROCK_LITTLE_ENDIAN_
+BEDROCK_INLINE_FUNCTION bool tok_is_eight_digits(const u64 chunk) {
+	return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL) && (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL);
+}
+
+// SWAR conversion of eight ASCII digits, merging pairs of digits, then pairs of pairs, and so on
+BEDROCK_INLINE_FUNCTION u32 tok_parse_eight_digits(u64 chunk) {
+	chunk = ((chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+	chunk = ((chunk & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+	return (u32) (((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+#endif // _BEDROCK_LITTLE_ENDIAN_
+
+BEDROCK_FUNCTION int tok_parse_u64(const char* str, const u64 len, u64* val) {
+	if (str == NULL || val == NULL || len == 0) return -1;
+
+	u64 i = 0;
+	u64 res = 0;
+	if (len > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+		for (i = 2; i < len; ++i) {
+			if (!IS_A_HEX_VAL(str[i]) || (res >> 60)) return -1;
+			res = (res << 4) | (u64) (IS_A_NUM(str[i]) ? CHR_TO_NUM(str[i]) : CHR_TO_HEX(str[i]));
+		}
+		*val = res;
+		return 0;
+	}
+
+#ifdef _BEDROCK_LITTLE_ENDIAN_
+	for (; (i + 8) <= len; i += 8) {
+		u64 chunk = 0;
+		__builtin_memcpy(&chunk, str + i, sizeof(chunk));
+		if (!tok_is_eight_digits(chunk)) break;
+		if (__builtin_mul_overflow(res, 100000000ULL, &res) || __builtin_add_overflow(res, (u64) tok_parse_eight_digits(chunk), &res)) return -1;
+	}
+#endif // _BEDROCK_LITTLE_ENDIAN_
+
+	for (; i < len; ++i) {
+		if (!IS_A_NUM(str[i])) return -1;
+		if (__builtin_mul_overflow(res, 10ULL, &res) || __builtin_add_overflow(res, (u64) CHR_TO_NUM(str[i]), &res)) return -1;
+	}
+
+	*val = res;
+
+	return 0;
+}
+
+BEDROCK_FUNCTION int tok_parse_s64(const char* str, const u64 len, s64* val) {
+	if (str == NULL || val == NULL || len == 0) return -1;
+
+	const bool is_neg = (str[0] == '-');
+	const u64 sign_len = (str[0] == '-' || str[0] == '+');
+
+	u64 magnitude = 0;
+	if (tok_parse_u64(str + sign_len, len - sign_len, &magnitude)) return -1;
+	if (magnitude > (u64) 0x7FFFFFFFFFFFFFFFULL + is_neg) return -1;
+
+	*val = is_neg ? (s64) (0ULL - magnitude) : (s64) magnitude;
+
+	return 0;
+}
+
+BEDROCK_INLINE_FUNCTION int tok_store_field(const BedrockColumn* column, const u64 record, const char* buf, const BedrockField field) {
+	switch (column -> type) {
+		case BEDROCK_COLUMN_FIELD:
+			CAST_PTR(column -> data, BedrockField)[record] = field;
+			return 0;
+		case BEDROCK_COLUMN_S64:
+			return tok_parse_s64(buf + field.offset, field.length, CAST_PTR(column -> data, s64) + record);
+		case BEDROCK_COLUMN_U64:
+			return tok_parse_u64(buf + field.offset, field.length, CAST_PTR(column -> data, u64) + record);
+	}
+	return -1;
+}
+
+// Stores the field of the given column, and checks the fields count once the record ends
+BEDROCK_INLINE_FUNCTION int tok_decode_field(const BedrockColumn* columns, const u64 columns_cnt, const u64 record, const u64 column, const char* buf, const BedrockField field, const bool is_eol) {
+	if (column < columns_cnt && tok_store_field(columns + column, record, buf, field)) {
+		BEDROCK_WARNING_LOG("Invalid field at record %llu, column %llu.", record, column);
+		return -1;
+	}
+
+	if (is_eol && column + 1 != columns_cnt) {
+		BEDROCK_WARNING_LOG("Record %llu has %llu fields instead of %llu.", record, column + 1, columns_cnt);
+		return -1;
+	}
+
+	return 0;
+}
+
+/// Decodes up to max_records records straight into the given columns in a single pass over buf.
+/// Returns the number of decoded records, or -1 on a malformed record (wrong field count, invalid number
+/// or a quoted field still open at the end of the input).
+/// If consumed is not NULL, it receives the offset right after the last decoded record, so that
+/// a batch stopped at max_records can be resumed by decoding again from buf + *consumed.
+BEDROCK_FUNCTION s64 tok_decode(BedrockTokenizer* tok, const char* buf, const u64 len, const BedrockColumn* columns, const u64 columns_cnt, const u64 max_records, u64* consumed) {
+	if (tok == NULL || buf == NULL || columns == NULL || columns_cnt == 0) return -1;
+
+	tok_reset(tok);
+
+	u64 record = 0;
+	u64 column = 0;
+	u64 start = 0;
+	BedrockField field = {0};
+	u8 tail[TOK_BLOCK_SIZE] = {0};
+	for (u64 base = 0; base < len && record < max_records; base += TOK_BLOCK_SIZE) {
+		const u8* block = CAST_PTR(buf + base, u8);
+		if (len - base < TOK_BLOCK_SIZE) {
+			__builtin_memcpy(tail, block, len - base);
+			block = tail;
+		}
+
+		u64 bits = tok_classify_block(tok, block);
+		while (bits && record < max_records) {
+			const u64 end = base + __builtin_ctzll(bits);
+			bits &= bits - 1;
+
+			// Skip empty lines
+			const bool is_eol = buf[end] == '\n';
+			if (!tok_boundary_field(tok, buf, &start, end, is_eol, column, &field)) continue;
+			if (tok_decode_field(columns, columns_cnt, record, column, buf, field, is_eol)) return -1;
+
+			if (is_eol) record++, column = 0;
+			else column++;
+		}
+	}
+
+	if (record == max_records) {
+		if (consumed != NULL) *consumed = MIN(start, len);
+		return record;
+	}
+
+	if (tok -> in_quote) {
+		BEDROCK_WARNING_LOG("Record %llu ends inside an unterminated quoted field.", record);
+		return -1;
+	}
+
+	// Last record without a trailing newline
+	if (tok_tail_field(tok, buf, len, &start, column, &field)) {
+		if (tok_decode_field(columns, columns_cnt, record, column, buf, field, TRUE)) return -1;
+		record++;
+	}
+
+	if (consumed != NULL) *consumed = len;
+
+	return record;
+}
+
+#endif //_BEDROCK_TOKENIZER_H_
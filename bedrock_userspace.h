@@ -6,5 +6,485 @@
 //  User Space Functions Declarations
 // -------------------------------------
 
-#endif //_BEDROCK_USERSPACE_H_
+/* -------------------------------------------------------------------------------------------------------- */
+// ---------------------------
+//  Work-Stealing Thread Pool
+// ---------------------------
+// Every worker owns a Chase-Lev deque: the owner pushes and takes at the bottom, while the idle
+// workers steal from the top. Tasks submitted from outside the pool go through a shared MPMC
+// injector queue. Tasks are small by-value records, so submitting never allocates, and when a
+// queue is full the task simply runs inline on the submitting thread.
+#ifdef _BEDROCK_THREAD_POOL_
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define TASK_DEQUE_CAPACITY    1024
+#define TASK_INJECTOR_CAPACITY 4096
+#define THREAD_POOL_SPIN_LIMIT 128
+#define PARALLEL_BLOCK_SIZE    (1ULL << 20)
+
+#define thread_pool_submit(pool, fn, arg, wait_group) thread_pool_submit_range(pool, fn, arg, 0, 0, wait_group)
+
+typedef void (*BedrockTaskFn)(void* arg, const u64 start, const u64 end);
+
+typedef struct BedrockWaitGroup {
+	u64 cnt;
+} BedrockWaitGroup;
+
+typedef struct BedrockTask {
+	BedrockTaskFn fn;
+	void* arg;
+	u64 start;
+	u64 end;
+	BedrockWaitGroup* wait_group;
+} BedrockTask;
+
+BEDROCK_MPMC_QUEUE(BedrockTaskQueue, BedrockTask)
+
+// NOTE: The indices are padded apart rather than aligned, as the workers array comes from bedrock_calloc
+typedef struct BedrockTaskDeque {
+	BedrockTask* buffer;
+	s64 mask;
+	s64 top;
+	u8 padding[BEDROCK_CACHE_LINE - sizeof(s64)];
+	s64 bottom;
+	u8 bottom_padding[BEDROCK_CACHE_LINE - sizeof(s64)];
+} BedrockTaskDeque;
+
+typedef struct BedrockThreadPool BedrockThreadPool;
+
+typedef struct BedrockWorker {
+	BedrockThreadPool* pool;
+	pthread_t thread;
+	u64 rng_state;
+	BedrockTaskDeque deque;
+} BedrockWorker;
+
+struct BedrockThreadPool {
+	BedrockWorker* workers;
+	u32 workers_cnt;
+	u32 threads_cnt;
+	BedrockTaskQueue injector;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	s64 pending;
+	u32 sleepers;
+	bool stop;
+};
+
+typedef struct BedrockParallelFor {
+	BedrockThreadPool* pool;
+	BedrockTaskFn fn;
+	void* arg;
+	u64 grain;
+	BedrockWaitGroup* wait_group;
+} BedrockParallelFor;
+
+typedef struct BedrockBulkOp {
+	void* dest;
+	const void* src;
+	u64 size;
+	u64 block_size;
+	int value;
+	u64 val_size;
+	char chr;
+	u64 cnt;
+} BedrockBulkOp;
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_FUNCTION int thread_pool_init(BedrockThreadPool* pool, u32 workers_cnt);
+BEDROCK_FUNCTION void thread_pool_deinit(BedrockThreadPool* pool);
+BEDROCK_FUNCTION void thread_pool_submit_range(BedrockThreadPool* pool, BedrockTaskFn fn, void* arg, const u64 start, const u64 end, BedrockWaitGroup* wait_group);
+BEDROCK_FUNCTION void thread_pool_wait(BedrockThreadPool* pool, BedrockWaitGroup* wait_group);
+BEDROCK_FUNCTION void parallel_for(BedrockThreadPool* pool, const u64 start, const u64 end, u64 grain, BedrockTaskFn fn, void* arg);
+BEDROCK_FUNCTION void* parallel_mem_cpy(BedrockThreadPool* pool, void* dest, const void* src, const u64 size);
+BEDROCK_FUNCTION void parallel_mem_set_var(BedrockThreadPool* pool, void* ptr, const int value, const u64 size, const u64 val_size);
+BEDROCK_FUNCTION u64 parallel_ref_chr_cnt(BedrockThreadPool* pool, const char* str, const u64 len, const char chr);
+BEDROCK_FUNCTION char* parallel_to_hex_str(BedrockThreadPool* pool, char* str, const u8* byte_str, const u64 byte_size);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+BEDROCK_INLINE_FUNCTION void wait_group_add(BedrockWaitGroup* wait_group, const u64 cnt) {
+	__atomic_add_fetch(&(wait_group -> cnt), cnt, __ATOMIC_RELAXED);
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION void wait_group_done(BedrockWaitGroup* wait_group) {
+	__atomic_sub_fetch(&(wait_group -> cnt), 1, __ATOMIC_RELEASE);
+	return;
+}
+
+// The slots are copied field by field with relaxed atomics, as a thief may read a slot that the owner is
+// overwriting: the thief then loses the CAS on top and discards the copy
+BEDROCK_INLINE_FUNCTION void task_store(BedrockTask* slot, const BedrockTask task) {
+	BEDROCK_ATOMIC_STORE(&(slot -> fn), task.fn, __ATOMIC_RELAXED);
+	BEDROCK_ATOMIC_STORE(&(slot -> arg), task.arg, __ATOMIC_RELAXED);
+	BEDROCK_ATOMIC_STORE(&(slot -> start), task.start, __ATOMIC_RELAXED);
+	BEDROCK_ATOMIC_STORE(&(slot -> end), task.end, __ATOMIC_RELAXED);
+	BEDROCK_ATOMIC_STORE(&(slot -> wait_group), task.wait_group, __ATOMIC_RELAXED);
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION BedrockTask task_load(BedrockTask* slot) {
+	BedrockTask task = {0};
+	task.fn = BEDROCK_ATOMIC_LOAD(&(slot -> fn), __ATOMIC_RELAXED);
+	task.arg = BEDROCK_ATOMIC_LOAD(&(slot -> arg), __ATOMIC_RELAXED);
+	task.start = BEDROCK_ATOMIC_LOAD(&(slot -> start), __ATOMIC_RELAXED);
+	task.end = BEDROCK_ATOMIC_LOAD(&(slot -> end), __ATOMIC_RELAXED);
+	task.wait_group = BEDROCK_ATOMIC_LOAD(&(slot -> wait_group), __ATOMIC_RELAXED);
+	return task;
+}
+
+BEDROCK_INLINE_FUNCTION bool task_deque_push(BedrockTaskDeque* deque, const BedrockTask task) {
+	const s64 bottom = BEDROCK_ATOMIC_LOAD(&(deque -> bottom), __ATOMIC_RELAXED);
+	const s64 top = BEDROCK_ATOMIC_LOAD(&(deque -> top), __ATOMIC_ACQUIRE);
+	if (bottom - top > deque -> mask) return FALSE;
+	task_store(deque -> buffer + (bottom & deque -> mask), task);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	BEDROCK_ATOMIC_STORE(&(deque -> bottom), bottom + 1, __ATOMIC_RELAXED);
+	return TRUE;
+}
+
+BEDROCK_INLINE_FUNCTION bool task_deque_take(BedrockTaskDeque* deque, BedrockTask* task) {
+	const s64 bottom = BEDROCK_ATOMIC_LOAD(&(deque -> bottom), __ATOMIC_RELAXED) - 1;
+	BEDROCK_ATOMIC_STORE(&(deque -> bottom), bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	s64 top = BEDROCK_ATOMIC_LOAD(&(deque -> top), __ATOMIC_RELAXED);
+	if (top > bottom) {
+		BEDROCK_ATOMIC_STORE(&(deque -> bottom), bottom + 1, __ATOMIC_RELAXED);
+		return FALSE;
+	}
+
+	*task = task_load(deque -> buffer + (bottom & deque -> mask));
+	if (top != bottom) return TRUE;
+
+	// Last task left, race against the thieves for it
+	const bool taken = __atomic_compare_exchange_n(&(deque -> top), &top, top + 1, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+	BEDROCK_ATOMIC_STORE(&(deque -> bottom), bottom + 1, __ATOMIC_RELAXED);
+
+	return taken;
+}
+
+BEDROCK_INLINE_FUNCTION bool task_deque_steal(BedrockTaskDeque* deque, BedrockTask* task) {
+	s64 top = BEDROCK_ATOMIC_LOAD(&(deque -> top), __ATOMIC_ACQUIRE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	const s64 bottom = BEDROCK_ATOMIC_LOAD(&(deque -> bottom), __ATOMIC_ACQUIRE);
+	if (top >= bottom) return FALSE;
+
+	*task = task_load(deque -> buffer + (top & deque -> mask));
+
+	return __atomic_compare_exchange_n(&(deque -> top), &top, top + 1, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+BEDROCK_INLINE_FUNCTION void thread_pool_run_task(const BedrockTask* task) {
+	(task -> fn)(task -> arg, task -> start, task -> end);
+	if (task -> wait_group != NULL) wait_group_done(task -> wait_group);
+	return;
+}
+
+// NOTE: Set by each worker on start, a thread that is not a worker of the pool (or a worker that runs code
+//       from another translation unit) sees NULL and simply goes through the injector
+static __thread BedrockWorker* thread_pool_worker = NULL;
+
+BEDROCK_INLINE_FUNCTION BedrockWorker* thread_pool_current_worker(BedrockThreadPool* pool) {
+	return (thread_pool_worker != NULL && thread_pool_worker -> pool == pool) ? thread_pool_worker : NULL;
+}
+
+// Looks into the own deque first, then the injector and finally tries to steal from random victims
+BEDROCK_FUNCTION bool thread_pool_find_task(BedrockThreadPool* pool, BedrockWorker* worker, BedrockTask* task) {
+	bool found = (worker != NULL && task_deque_take(&(worker -> deque), task)) || BedrockTaskQueue_pop(&(pool -> injector), task);
+
+	u64 rng_state = (worker != NULL) ? worker -> rng_state : (u64) task;
+	for (u32 i = 0; !found && i < pool -> workers_cnt; ++i) {
+		// xorshift64
+		rng_state ^= rng_state << 13, rng_state ^= rng_state >> 7, rng_state ^= rng_state << 17;
+		BedrockWorker* victim = pool -> workers + (rng_state % pool -> workers_cnt);
+		if (victim != worker) found = task_deque_steal(&(victim -> deque), task);
+	}
+	if (worker != NULL) worker -> rng_state = rng_state;
+
+	if (found) __atomic_sub_fetch(&(pool -> pending), 1, __ATOMIC_SEQ_CST);
+
+	return found;
+}
+
+BEDROCK_FUNCTION void* thread_pool_worker_main(void* arg) {
+	BedrockWorker* worker = (BedrockWorker*) arg;
+	BedrockThreadPool* pool = worker -> pool;
+
+	thread_pool_worker = worker;
+
+	u64 idle = 0;
+	while (!BEDROCK_ATOMIC_LOAD(&(pool -> stop), __ATOMIC_ACQUIRE)) {
+		BedrockTask task = {0};
+		if (thread_pool_find_task(pool, worker, &task)) {
+			thread_pool_run_task(&task);
+			idle = 0;
+			continue;
+		}
+
+		if (++idle < THREAD_POOL_SPIN_LIMIT) {
+			BEDROCK_CPU_RELAX();
+			continue;
+		}
+
+		// NOTE: sleepers is published before re-checking pending, while submitters bump pending before
+		//       checking sleepers, so at least one of the two sides always sees the other one
+		pthread_mutex_lock(&(pool -> lock));
+		__atomic_add_fetch(&(pool -> sleepers), 1, __ATOMIC_SEQ_CST);
+		while (!BEDROCK_ATOMIC_LOAD(&(pool -> stop), __ATOMIC_ACQUIRE) && BEDROCK_ATOMIC_LOAD(&(pool -> pending), __ATOMIC_SEQ_CST) <= 0) {
+			pthread_cond_wait(&(pool -> cond), &(pool -> lock));
+		}
+		__atomic_sub_fetch(&(pool -> sleepers), 1, __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(&(pool -> lock));
+		idle = 0;
+	}
+
+	return NULL;
+}
+
+/// Starts workers_cnt workers, or one per online core if workers_cnt is 0.
+BEDROCK_FUNCTION int thread_pool_init(BedrockThreadPool* pool, u32 workers_cnt) {
+	if (pool == NULL) return -1;
+	if (workers_cnt == 0) workers_cnt = MAX(1, sysconf(_SC_NPROCESSORS_ONLN));
+
+	mem_set(pool, 0, sizeof(BedrockThreadPool));
+	if (BedrockTaskQueue_init(&(pool -> injector), TASK_INJECTOR_CAPACITY)) return -1;
 
+	pool -> workers = (BedrockWorker*) bedrock_calloc(workers_cnt, sizeof(BedrockWorker));
+	if (pool -> workers == NULL) {
+		BEDROCK_WARNING_LOG("Failed to allocate the %u workers of the thread pool.", workers_cnt);
+		BedrockTaskQueue_deinit(&(pool -> injector));
+		return -1;
+	}
+
+	pthread_mutex_init(&(pool -> lock), NULL);
+	pthread_cond_init(&(pool -> cond), NULL);
+	pool -> workers_cnt = workers_cnt;
+
+	for (u32 i = 0; i < workers_cnt; ++i) {
+		BedrockWorker* worker = pool -> workers + i;
+		worker -> pool = pool;
+		worker -> rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+		worker -> deque.mask = TASK_DEQUE_CAPACITY - 1;
+		worker -> deque.buffer = (BedrockTask*) bedrock_calloc(TASK_DEQUE_CAPACITY, sizeof(BedrockTask));
+		if (worker -> deque.buffer == NULL) {
+			BEDROCK_WARNING_LOG("Failed to allocate the deque of the worker %u.", i);
+			thread_pool_deinit(pool);
+			return -1;
+		}
+	}
+
+	int err = 0;
+	for (; pool -> threads_cnt < workers_cnt; ++(pool -> threads_cnt)) {
+		BedrockWorker* worker = pool -> workers + pool -> threads_cnt;
+		if ((err = pthread_create(&(worker -> thread), NULL, thread_pool_worker_main, worker))) {
+			BEDROCK_WARNING_LOG("Failed to create the worker thread %u.", pool -> threads_cnt);
+			break;
+		}
+	}
+
+	if (err) {
+		thread_pool_deinit(pool);
+		return -1;
+	}
+
+	return 0;
+}
+
+BEDROCK_FUNCTION void thread_pool_deinit(BedrockThreadPool* pool) {
+	if (pool == NULL || pool -> workers == NULL) return;
+
+	pthread_mutex_lock(&(pool -> lock));
+	BEDROCK_ATOMIC_STORE(&(pool -> stop), TRUE, __ATOMIC_RELEASE);
+	pthread_cond_broadcast(&(pool -> cond));
+	pthread_mutex_unlock(&(pool -> lock));
+
+	for (u32 i = 0; i < pool -> threads_cnt; ++i) pthread_join(pool -> workers[i].thread, NULL);
+
+	// Drain whatever was left behind, so that no waiter is left hanging
+	BedrockTask task = {0};
+	while (BedrockTaskQueue_pop(&(pool -> injector), &task)) thread_pool_run_task(&task);
+
+	for (u32 i = 0; i < pool -> workers_cnt; ++i) {
+		if (pool -> workers[i].deque.buffer == NULL) continue;
+		while (task_deque_take(&(pool -> workers[i].deque), &task)) thread_pool_run_task(&task);
+		bedrock_free(pool -> workers[i].deque.buffer);
+	}
+
+	bedrock_free(pool -> workers);
+	pool -> workers = NULL;
+	pool -> workers_cnt = 0;
+	pool -> threads_cnt = 0;
+
+	BedrockTaskQueue_deinit(&(pool -> injector));
+	pthread_cond_destroy(&(pool -> cond));
+	pthread_mutex_destroy(&(pool -> lock));
+
+	return;
+}
+
+BEDROCK_FUNCTION void thread_pool_submit_range(BedrockThreadPool* pool, BedrockTaskFn fn, void* arg, const u64 start, const u64 end, BedrockWaitGroup* wait_group) {
+	if (fn == NULL) return;
+
+	const BedrockTask task = { .fn = fn, .arg = arg, .start = start, .end = end, .wait_group = wait_group };
+	if (wait_group != NULL) wait_group_add(wait_group, 1);
+
+	if (pool == NULL) {
+		thread_pool_run_task(&task);
+		return;
+	}
+
+	BedrockWorker* worker = thread_pool_current_worker(pool);
+	const bool queued = (worker != NULL) ? task_deque_push(&(worker -> deque), task) : BedrockTaskQueue_push(&(pool -> injector), task);
+	if (!queued) {
+		thread_pool_run_task(&task);
+		return;
+	}
+
+	__atomic_add_fetch(&(pool -> pending), 1, __ATOMIC_SEQ_CST);
+	if (BEDROCK_ATOMIC_LOAD(&(pool -> sleepers), __ATOMIC_SEQ_CST) > 0) {
+		pthread_mutex_lock(&(pool -> lock));
+		pthread_cond_signal(&(pool -> cond));
+		pthread_mutex_unlock(&(pool -> lock));
+	}
+
+	return;
+}
+
+/// Waits for the wait group to drain, running the pending tasks in the meantime, so that waiting
+/// from within a task cannot deadlock the pool.
+BEDROCK_FUNCTION void thread_pool_wait(BedrockThreadPool* pool, BedrockWaitGroup* wait_group) {
+	if (wait_group == NULL) return;
+
+	BedrockWorker* worker = (pool != NULL) ? thread_pool_current_worker(pool) : NULL;
+	u64 spins = 0;
+	while (BEDROCK_ATOMIC_LOAD(&(wait_group -> cnt), __ATOMIC_ACQUIRE) > 0) {
+		BedrockTask task = {0};
+		if (pool != NULL && thread_pool_find_task(pool, worker, &task)) {
+			thread_pool_run_task(&task);
+			continue;
+		}
+
+		if (++spins % THREAD_POOL_SPIN_LIMIT) BEDROCK_CPU_RELAX();
+		else sched_yield();
+	}
+
+	return;
+}
+
+// Splits the range in halves, pushing the upper ones to be stolen, until it fits in the grain
+BEDROCK_FUNCTION void parallel_for_split(void* arg, const u64 start, const u64 end) {
+	const BedrockParallelFor* ctx = (const BedrockParallelFor*) arg;
+
+	u64 split_end = end;
+	while (split_end - start > ctx -> grain) {
+		const u64 mid = start + (split_end - start) / 2;
+		thread_pool_submit_range(ctx -> pool, parallel_for_split, arg, mid, split_end, ctx -> wait_group);
+		split_end = mid;
+	}
+
+	(ctx -> fn)(ctx -> arg, start, split_end);
+
+	return;
+}
+
+/// Runs fn over [start, end) in chunks of at most grain indices (0 picks about eight chunks per worker).
+BEDROCK_FUNCTION void parallel_for(BedrockThreadPool* pool, const u64 start, const u64 end, u64 grain, BedrockTaskFn fn, void* arg) {
+	if (fn == NULL || start >= end) return;
+
+	if (pool == NULL) {
+		fn(arg, start, end);
+		return;
+	}
+
+	if (grain == 0) grain = MAX(1, __ceil(end - start, (u64) pool -> workers_cnt * 8));
+
+	BedrockWaitGroup wait_group = {0};
+	BedrockParallelFor ctx = { .pool = pool, .fn = fn, .arg = arg, .grain = grain, .wait_group = &wait_group };
+	thread_pool_submit_range(pool, parallel_for_split, &ctx, start, end, &wait_group);
+	thread_pool_wait(pool, &wait_group);
+
+	return;
+}
+
+BEDROCK_INLINE_FUNCTION u64 parallel_block_end(const BedrockBulkOp* op, const u64 block) {
+	return MIN(block * op -> block_size, op -> size);
+}
+
+BEDROCK_FUNCTION void parallel_mem_cpy_blocks(void* arg, const u64 start, const u64 end) {
+	const BedrockBulkOp* op = (const BedrockBulkOp*) arg;
+	const u64 from = start * op -> block_size;
+	mem_cpy(CAST_PTR(op -> dest, u8) + from, CAST_PTR(op -> src, u8) + from, parallel_block_end(op, end) - from);
+	return;
+}
+
+BEDROCK_FUNCTION void parallel_mem_set_var_blocks(void* arg, const u64 start, const u64 end) {
+	const BedrockBulkOp* op = (const BedrockBulkOp*) arg;
+	const u64 from = start * op -> block_size;
+	mem_set_var(CAST_PTR(op -> dest, u8) + from, op -> value, parallel_block_end(op, end) - from, op -> val_size);
+	return;
+}
+
+BEDROCK_FUNCTION void parallel_ref_chr_cnt_blocks(void* arg, const u64 start, const u64 end) {
+	BedrockBulkOp* op = (BedrockBulkOp*) arg;
+	const u64 to = parallel_block_end(op, end);
+	u64 cnt = 0;
+	for (u64 from = start * op -> block_size; from < to; from += op -> block_size) {
+		cnt += ref_chr_cnt(CAST_PTR(op -> src, char) + from, (unsigned int) (MIN(from + op -> block_size, to) - from), op -> chr);
+	}
+	__atomic_add_fetch(&(op -> cnt), cnt, __ATOMIC_RELAXED);
+	return;
+}
+
+// NOTE: to_hex_str can not be used per block, as its terminator would overwrite the first digit of the next block
+BEDROCK_FUNCTION void parallel_to_hex_str_blocks(void* arg, const u64 start, const u64 end) {
+	const BedrockBulkOp* op = (const BedrockBulkOp*) arg;
+	const u8* byte_str = CAST_PTR(op -> src, u8);
+	char* str = CAST_PTR(op -> dest, char) + 2 * start * op -> block_size;
+	for (u64 j = start * op -> block_size; j < parallel_block_end(op, end); ++j) {
+		*str++ = HEX_TO_CHR_CAP((byte_str[j] >> 4) & 0xF);
+		*str++ = HEX_TO_CHR_CAP(byte_str[j] & 0xF);
+	}
+	return;
+}
+
+BEDROCK_FUNCTION void* parallel_mem_cpy(BedrockThreadPool* pool, void* dest, const void* src, const u64 size) {
+	if (dest == NULL || src == NULL) return NULL;
+	BedrockBulkOp op = { .dest = dest, .src = src, .size = size, .block_size = PARALLEL_BLOCK_SIZE };
+	parallel_for(pool, 0, __ceil(size, op.block_size), 1, parallel_mem_cpy_blocks, &op);
+	return dest;
+}
+
+BEDROCK_FUNCTION void parallel_mem_set_var(BedrockThreadPool* pool, void* ptr, const int value, const u64 size, const u64 val_size) {
+	if (ptr == NULL || val_size == 0) return;
+	// Each block has to start on a pattern boundary, and holds at least one pattern when val_size exceeds PARALLEL_BLOCK_SIZE
+	BedrockBulkOp op = { .dest = ptr, .size = size, .block_size = MAX(val_size, PARALLEL_BLOCK_SIZE - (PARALLEL_BLOCK_SIZE % val_size)), .value = value, .val_size = val_size };
+	parallel_for(pool, 0, __ceil(size, op.block_size), 1, parallel_mem_set_var_blocks, &op);
+	return;
+}
+
+BEDROCK_FUNCTION u64 parallel_ref_chr_cnt(BedrockThreadPool* pool, const char* str, const u64 len, const char chr) {
+	if (str == NULL) return 0;
+	BedrockBulkOp op = { .src = str, .size = len, .block_size = PARALLEL_BLOCK_SIZE, .chr = chr };
+	parallel_for(pool, 0, __ceil(len, op.block_size), 1, parallel_ref_chr_cnt_blocks, &op);
+	return op.cnt;
+}
+
+BEDROCK_FUNCTION char* parallel_to_hex_str(BedrockThreadPool* pool, char* str, const u8* byte_str, const u64 byte_size) {
+	if (str == NULL || byte_str == NULL) return NULL;
+	BedrockBulkOp op = { .dest = str, .src = byte_str, .size = byte_size, .block_size = PARALLEL_BLOCK_SIZE };
+	parallel_for(pool, 0, __ceil(byte_size, op.block_size), 1, parallel_to_hex_str_blocks, &op);
+	str[2 * byte_size] = '\0';
+	return str;
+}
+
+#endif //_BEDROCK_THREAD_POOL_
+
+#endif //_BEDROCK_USERSPACE_H_
@@ -0,0 +1,486 @@
+#ifndef _BEDROCK_UTF8_H_
+#define _BEDROCK_UTF8_H_
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ---------------
+//  UTF-8 Support
+// ---------------
+// Validation follows the lookup-table approach of Keiser and Lemire: the high/low nibbles of each
+// byte and of its predecessor index three 16-entries tables (pshufb), whose AND is non-zero only
+// for invalid pairs, while the 3/4-bytes continuations are checked on the bytes two and three behind.
+#define UTF8_TOO_SHORT  (1 << 0) // 11______ 0_______ or 11______ 11______
+#define UTF8_TOO_LONG   (1 << 1) // 0_______ 10______
+#define UTF8_OVERLONG_3 (1 << 2) // 11100000 100_____
+#define UTF8_TOO_LARGE  (1 << 3) // 11110100 1001____ or 11110101+ 1001____+
+#define UTF8_SURROGATE  (1 << 4) // 11101101 101_____
+#define UTF8_OVERLONG_2 (1 << 5) // 1100000_ 10______
+#define UTF8_OVERLONG_4 (1 << 6) // 11110000 1000____
+#define UTF8_TWO_CONTS  (1 << 7) // 10______ 10______
+#define UTF8_TOO_LARGE_1000 UTF8_OVERLONG_4 // 11110101+ 1000____
+#define UTF8_CARRY      (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#define UTF8_IS_CONTINUATION(byte) (((u8) (byte) & 0xC0) == 0x80)
+#define UTF8_MAX_CODE_POINT        0x10FFFF
+#define UTF8_ASCII_MASK            0x8080808080808080ULL
+
+// ------------------------
+//  Functions Declarations
+// ------------------------
+BEDROCK_INLINE_FUNCTION u8 utf8_decode(const u8* str, const u64 len, u32* code_point);
+BEDROCK_INLINE_FUNCTION u8 utf8_encode(const u32 code_point, u8* str);
+BEDROCK_FUNCTION bool utf8_is_ascii(const char* str, const u64 len);
+BEDROCK_FUNCTION bool utf8_validate(const char* str, const u64 len);
+BEDROCK_FUNCTION u64 utf8_count(const char* str, const u64 len);
+BEDROCK_FUNCTION s64 utf8_to_utf32(const char* str, const u64 len, u32* dest);
+BEDROCK_FUNCTION s64 utf8_to_utf16(const char* str, const u64 len, u16* dest);
+BEDROCK_FUNCTION s64 utf32_to_utf8(const u32* src, const u64 len, char* dest);
+BEDROCK_FUNCTION s64 utf16_to_utf8(const u16* src, const u64 len, char* dest);
+BEDROCK_FUNCTION char* utf8_reverse_str(char* str);
+BEDROCK_INLINE_FUNCTION u32 utf8_fold_code_point(const u32 code_point);
+BEDROCK_FUNCTION char* utf8_case_fold(char* str);
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------------------
+//  Functions Definitions
+// -----------------------
+/// Decodes a single code point, returning its encoded size or 0 if the sequence is invalid (overlong, surrogate, truncated...).
+BEDROCK_INLINE_FUNCTION u8 utf8_decode(const u8* str, const u64 len, u32* code_point) {
+	if (len == 0) return 0;
+
+	const u8 lead = str[0];
+	if (lead < 0x80) {
+		*code_point = lead;
+		return 1;
+	} else if (lead < 0xC2) {
+		return 0;
+	} else if (lead < 0xE0) {
+		if (len < 2 || !UTF8_IS_CONTINUATION(str[1])) return 0;
+		*code_point = ((u32) (lead & 0x1F) << 6) | (str[1] & 0x3F);
+		return 2;
+	} else if (lead < 0xF0) {
+		if (len < 3 || !UTF8_IS_CONTINUATION(str[1]) || !UTF8_IS_CONTINUATION(str[2])) return 0;
+		const u32 cp = ((u32) (lead & 0x0F) << 12) | ((u32) (str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+		if (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF)) return 0;
+		*code_point = cp;
+		return 3;
+	} else if (lead < 0xF5) {
+		if (len < 4 || !UTF8_IS_CONTINUATION(str[1]) || !UTF8_IS_CONTINUATION(str[2]) || !UTF8_IS_CONTINUATION(str[3])) return 0;
+		const u32 cp = ((u32) (lead & 0x07) << 18) | ((u32) (str[1] & 0x3F) << 12) | ((u32) (str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+		if (cp < 0x10000 || cp > UTF8_MAX_CODE_POINT) return 0;
+		*code_point = cp;
+		return 4;
+	}
+
+	return 0;
+}
+
+/// Encodes the code point into str (at least 4 bytes), returning the encoded size or 0 if it is not a scalar value.
+BEDROCK_INLINE_FUNCTION u8 utf8_encode(const u32 code_point, u8* str) {
+	if (code_point < 0x80) {
+		str[0] = (u8) code_point;
+		return 1;
+	} else if (code_point < 0x800) {
+		str[0] = (u8) (0xC0 | (code_point >> 6));
+		str[1] = (u8) (0x80 | (code_point & 0x3F));
+		return 2;
+	} else if (code_point < 0x10000) {
+		if (code_point >= 0xD800 && code_point <= 0xDFFF) return 0;
+		str[0] = (u8) (0xE0 | (code_point >> 12));
+		str[1] = (u8) (0x80 | ((code_point >> 6) & 0x3F));
+		str[2] = (u8) (0x80 | (code_point & 0x3F));
+		return 3;
+	} else if (code_point <= UTF8_MAX_CODE_POINT) {
+		str[0] = (u8) (0xF0 | (code_point >> 18));
+		str[1] = (u8) (0x80 | ((code_point >> 12) & 0x3F));
+		str[2] = (u8) (0x80 | ((code_point >> 6) & 0x3F));
+		str[3] = (u8) (0x80 | (code_point & 0x3F));
+		return 4;
+	}
+
+	return 0;
+}
+
+BEDROCK_FUNCTION bool utf8_is_ascii(const char* str, const u64 len) {
+	if (str == NULL) return TRUE;
+
+	u64 i = 0;
+#if defined(_BEDROCK_SSE2_)
+	__m128i acc = _mm_setzero_si128();
+	for (; (i + 64) <= len; i += 64) {
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i*) (str + i)));
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i*) (str + i + 16)));
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i*) (str + i + 32)));
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i*) (str + i + 48)));
+		if (_mm_movemask_epi8(acc)) return FALSE;
+	}
+#endif // _BEDROCK_SSE2_
+
+	u64 acc_bits = 0;
+	for (; (i + 8) <= len; i += 8) {
+		u64 chunk = 0;
+		__builtin_memcpy(&chunk, str + i, sizeof(chunk));
+		acc_bits |= chunk;
+	}
+	for (; i < len; ++i) acc_bits |= (u8) str[i];
+
+	return (acc_bits & UTF8_ASCII_MASK) == 0;
+}
+
+#if defined(_BEDROCK_SSSE3_)
+BEDROCK_INLINE_FUNCTION __m128i utf8_check_special_cases(const __m128i input, const __m128i prev1) {
+	const __m128i low_nibble = _mm_set1_epi8(0x0F);
+
+	const __m128i byte_1_high_table = _mm_setr_epi8(
+		// 0_______ ________ <ASCII in byte 1>
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		// 10______ ________ <continuation in byte 1>
+		(char) UTF8_TWO_CONTS, (char) UTF8_TWO_CONTS, (char) UTF8_TWO_CONTS, (char) UTF8_TWO_CONTS,
+		// 1100____ ________ <two byte lead in byte 1>
+		UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+		// 1101____ ________ <two byte lead in byte 1>
+		UTF8_TOO_SHORT,
+		// 1110____ ________ <three byte lead in byte 1>
+		UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+		// 1111____ ________ <four+ byte lead in byte 1>
+		UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+	);
+
+	const __m128i byte_1_low_table = _mm_setr_epi8(
+		// ____0000 ________
+		(char) (UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+		// ____0001 ________
+		(char) (UTF8_CARRY | UTF8_OVERLONG_2),
+		// ____001_ ________
+		(char) UTF8_CARRY, (char) UTF8_CARRY,
+		// ____0100 ________
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE),
+		// ____0101 ________
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		// ____011_ ________
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		// ____1___ ________
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		// ____1101 ________
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+		(char) (UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000)
+	);
+
+	const __m128i byte_2_high_table = _mm_setr_epi8(
+		// ________ 0_______ <ASCII in byte 2>
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		// ________ 1000____
+		(char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+		// ________ 1001____
+		(char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+		// ________ 101_____
+		(char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+		(char) (UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+		// ________ 11______
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+	);
+
+	const __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+	const __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, low_nibble));
+	const __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+
+	return _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+}
+
+BEDROCK_INLINE_FUNCTION __m128i utf8_check_block(const __m128i input, const __m128i prev_input) {
+	const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+	const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+	const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+	// Only 111_____ and 1111____ survive the saturating subtraction with their top bit set
+	const __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8((char) (0xE0 - 0x80)));
+	const __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8((char) (0xF0 - 0x80)));
+	const __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8((char) 0x80));
+
+	return _mm_xor_si128(must_be_continuation, utf8_check_special_cases(input, prev1));
+}
+#endif // _BEDROCK_SSSE3_
+
+BEDROCK_FUNCTION bool utf8_validate(const char* str, const u64 len) {
+	if (str == NULL) return len == 0;
+
+	const u8* data = CAST_PTR(str, u8);
+	u64 i = 0;
+
+#if defined(_BEDROCK_SSSE3_)
+	const __m128i max_value = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char) (0xF0 - 1), (char) (0xE0 - 1), (char) (0xC0 - 1));
+	__m128i error = _mm_setzero_si128();
+	__m128i prev_input = _mm_setzero_si128();
+	__m128i prev_incomplete = _mm_setzero_si128();
+
+	u8 tail[16] = {0};
+	for (; i < len; i += 16) {
+		__m128i input;
+		if ((len - i) >= 16) {
+			input = _mm_loadu_si128((const __m128i*) (data + i));
+		} else {
+			// Zero padding is ASCII, so a truncated sequence at the end is reported as TOO_SHORT
+			__builtin_memcpy(tail, data + i, len - i);
+			input = _mm_loadu_si128((const __m128i*) tail);
+		}
+
+		if (_mm_movemask_epi8(input) == 0) {
+			error = _mm_or_si128(error, prev_incomplete);
+		} else {
+			error = _mm_or_si128(error, utf8_check_block(input, prev_input));
+			prev_incomplete = _mm_subs_epu8(input, max_value);
+		}
+		prev_input = input;
+	}
+
+	error = _mm_or_si128(error, prev_incomplete);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+#else
+	while (i < len) {
+		if ((i + 8) <= len) {
+			u64 chunk = 0;
+			__builtin_memcpy(&chunk, data + i, sizeof(chunk));
+			if ((chunk & UTF8_ASCII_MASK) == 0) {
+				i += 8;
+				continue;
+			}
+		}
+
+		u32 code_point = 0;
+		const u8 size = utf8_decode(data + i, len - i, &code_point);
+		if (size == 0) return FALSE;
+		i += size;
+	}
+
+	return TRUE;
+#endif // _BEDROCK_SSSE3_
+}
+
+/// Counts the code points of a valid UTF-8 string, that is the number of non-continuation bytes.
+BEDROCK_FUNCTION u64 utf8_count(const char* str, const u64 len) {
+	if (str == NULL) return 0;
+
+	u64 cnt = 0;
+	u64 i = 0;
+#if defined(_BEDROCK_SSE2_)
+	// Continuation bytes (0x80 - 0xBF) are the only ones below -65 as signed bytes
+	const __m128i threshold = _mm_set1_epi8(-65);
+	for (; (i + 16) <= len; i += 16) {
+		const __m128i chunk = _mm_loadu_si128((const __m128i*) (str + i));
+		cnt += __builtin_popcount((u32) _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, threshold)));
+	}
+#endif // _BEDROCK_SSE2_
+
+	for (; i < len; ++i) cnt += !UTF8_IS_CONTINUATION(str[i]);
+
+	return cnt;
+}
+
+/// Returns the number of code points written into dest (at least len entries), or -1 if str is not valid UTF-8.
+BEDROCK_FUNCTION s64 utf8_to_utf32(const char* str, const u64 len, u32* dest) {
+	if (str == NULL || dest == NULL) return -1;
+
+	const u8* data = CAST_PTR(str, u8);
+	u32* const dest_base = dest;
+	u64 i = 0;
+	while (i < len) {
+#if defined(_BEDROCK_SSE2_)
+		if ((i + 16) <= len) {
+			const __m128i chunk = _mm_loadu_si128((const __m128i*) (data + i));
+			if (_mm_movemask_epi8(chunk) == 0) {
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+				const __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+				_mm_storeu_si128((__m128i*) dest, _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*) (dest + 4), _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128((__m128i*) (dest + 8), _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128((__m128i*) (dest + 12), _mm_unpackhi_epi16(hi, zero));
+				i += 16, dest += 16;
+				continue;
+			}
+		}
+#endif // _BEDROCK_SSE2_
+
+		u32 code_point = 0;
+		const u8 size = utf8_decode(data + i, len - i, &code_point);
+		if (size == 0) return -1;
+		*dest++ = code_point;
+		i += size;
+	}
+
+	return dest - dest_base;
+}
+
+/// Returns the number of code units written into dest (at least len entries), or -1 if str is not valid UTF-8.
+BEDROCK_FUNCTION s64 utf8_to_utf16(const char* str, const u64 len, u16* dest) {
+	if (str == NULL || dest == NULL) return -1;
+
+	const u8* data = CAST_PTR(str, u8);
+	u16* const dest_base = dest;
+	u64 i = 0;
+	while (i < len) {
+#if defined(_BEDROCK_SSE2_)
+		if ((i + 16) <= len) {
+			const __m128i chunk = _mm_loadu_si128((const __m128i*) (data + i));
+			if (_mm_movemask_epi8(chunk) == 0) {
+				const __m128i zero = _mm_setzero_si128();
+				_mm_storeu_si128((__m128i*) dest, _mm_unpacklo_epi8(chunk, zero));
+				_mm_storeu_si128((__m128i*) (dest + 8), _mm_unpackhi_epi8(chunk, zero));
+				i += 16, dest += 16;
+				continue;
+			}
+		}
+#endif // _BEDROCK_SSE2_
+
+		u32 code_point = 0;
+		const u8 size = utf8_decode(data + i, len - i, &code_point);
+		if (size == 0) return -1;
+		if (code_point >= 0x10000) {
+			code_point -= 0x10000;
+			*dest++ = (u16) (0xD800 | (code_point >> 10));
+			*dest++ = (u16) (0xDC00 | (code_point & 0x3FF));
+		} else *dest++ = (u16) code_point;
+		i += size;
+	}
+
+	return dest - dest_base;
+}
+
+/// Returns the number of bytes written into dest (at least 4 * len bytes), or -1 on a non-scalar code point.
+BEDROCK_FUNCTION s64 utf32_to_utf8(const u32* src, const u64 len, char* dest) {
+	if (src == NULL || dest == NULL) return -1;
+
+	u8* out = CAST_PTR(dest, u8);
+	u64 i = 0;
+	while (i < len) {
+#if defined(_BEDROCK_SSE2_)
+		if ((i + 8) <= len) {
+			const __m128i lo = _mm_loadu_si128((const __m128i*) (src + i));
+			const __m128i hi = _mm_loadu_si128((const __m128i*) (src + i + 4));
+			const __m128i non_ascii = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi32((int) 0xFFFFFF80));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(non_ascii, _mm_setzero_si128())) == 0xFFFF) {
+				const __m128i words = _mm_packs_epi32(lo, hi);
+				_mm_storel_epi64((__m128i*) out, _mm_packus_epi16(words, words));
+				i += 8, out += 8;
+				continue;
+			}
+		}
+#endif // _BEDROCK_SSE2_
+
+		const u8 size = utf8_encode(src[i], out);
+		if (size == 0) return -1;
+		out += size, ++i;
+	}
+
+	return out - CAST_PTR(dest, u8);
+}
+
+/// Returns the number of bytes written into dest (at least 3 * len bytes), or -1 on an unpaired surrogate.
+BEDROCK_FUNCTION s64 utf16_to_utf8(const u16* src, const u64 len, char* dest) {
+	if (src == NULL || dest == NULL) return -1;
+
+	u8* out = CAST_PTR(dest, u8);
+	u64 i = 0;
+	while (i < len) {
+#if defined(_BEDROCK_SSE2_)
+		if ((i + 8) <= len) {
+			const __m128i chunk = _mm_loadu_si128((const __m128i*) (src + i));
+			const __m128i non_ascii = _mm_and_si128(chunk, _mm_set1_epi16((short) 0xFF80));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(non_ascii, _mm_setzero_si128())) == 0xFFFF) {
+				_mm_storel_epi64((__m128i*) out, _mm_packus_epi16(chunk, chunk));
+				i += 8, out += 8;
+				continue;
+			}
+		}
+#endif // _BEDROCK_SSE2_
+
+		u32 code_point = src[i++];
+		if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+			if (i >= len || src[i] < 0xDC00 || src[i] > 0xDFFF) return -1;
+			code_point = 0x10000 + ((code_point - 0xD800) << 10) + (src[i++] - 0xDC00);
+		}
+
+		const u8 size = utf8_encode(code_point, out);
+		if (size == 0) return -1;
+		out += size;
+	}
+
+	return out - CAST_PTR(dest, u8);
+}
+
+/// Reverses the string by code points, unlike reverse_str which would split the multi-byte sequences.
+BEDROCK_FUNCTION char* utf8_reverse_str(char* str) {
+	if (str == NULL) return str;
+
+	reverse_str(str);
+
+	// Each multi-byte sequence now has its continuation bytes before the lead byte, so flip them back
+	for (char* chr = str; *chr; ++chr) {
+		if (!UTF8_IS_CONTINUATION(*chr)) continue;
+		char* end = chr;
+		while (end[1] && UTF8_IS_CONTINUATION(end[1])) ++end;
+		if (end[1]) ++end;
+		for (char* start = chr, * last = end; start < last; ++start, --last) {
+			const char temp = *start;
+			*start = *last;
+			*last = temp;
+		}
+		chr = end;
+	}
+
+	return str;
+}
+
+/// Simple case folding for Basic Latin, Latin-1, Latin Extended-A, Greek and Cyrillic,
+/// restricted to the mappings that preserve the encoded length.
+BEDROCK_INLINE_FUNCTION u32 utf8_fold_code_point(const u32 code_point) {
+	if (IS_UPPER_CASE(code_point)) return code_point + 32;
+	else if (code_point < 0xC0) return code_point;
+	else if (code_point <= 0xDE) return (code_point == 0xD7) ? code_point : code_point + 32;
+	else if (code_point >= 0x100 && code_point <= 0x137) return (code_point == 0x130) ? code_point : (code_point | 1);
+	else if (code_point >= 0x139 && code_point <= 0x148) return code_point + (code_point & 1);
+	else if (code_point >= 0x14A && code_point <= 0x177) return code_point | 1;
+	else if (code_point == 0x178) return 0xFF;
+	else if (code_point >= 0x179 && code_point <= 0x17E) return code_point + (code_point & 1);
+	else if (code_point >= 0x391 && code_point <= 0x3AB) return (code_point == 0x3A2) ? code_point : code_point + 32;
+	else if (code_point >= 0x400 && code_point <= 0x40F) return code_point + 80;
+	else if (code_point >= 0x410 && code_point <= 0x42F) return code_point + 32;
+	return code_point;
+}
+
+/// Case folds the string in place, invalid sequences are left untouched.
+BEDROCK_FUNCTION char* utf8_case_fold(char* str) {
+	if (str == NULL) return str;
+
+	const u64 len = str_len(str);
+	u8* data = CAST_PTR(str, u8);
+	for (u64 i = 0; i < len;) {
+		if (data[i] < 0x80) {
+			if (IS_UPPER_CASE(data[i])) data[i] += 32;
+			++i;
+			continue;
+		}
+
+		u32 code_point = 0;
+		const u8 size = utf8_decode(data + i, len - i, &code_point);
+		if (size == 0) {
+			++i;
+			continue;
+		}
+
+		utf8_encode(utf8_fold_code_point(code_point), data + i);
+		i += size;
+	}
+
+	return str;
+}
+
+#endif //_BEDROCK_UTF8_H_
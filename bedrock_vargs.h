@@ -12,56 +12,62 @@
 // ------------------------
 BEDROCK_FUNCTION int bedrock_snprintf(char* str, const u64 size, const char* format, ...);
 BEDROCK_FUNCTION int bedrock_vsnprintf(char* str, const u64 size, const char* format, const va_list args);
-BEDROCK_FUNCTION_INLINE u64 hex_to_str(char* str, u64 val, const u64 size);
-BEDROCK_FUNCTION_INLINE u64 oct_to_str(char* str, u64 val, const u64 size);
-BEDROCK_FUNCTION_INLINE u64 dec_to_str(char* str, s64 val, const bool is_neg);
+BEDROCK_INLINE_FUNCTION u64 hex_to_str(char* str, u64 val, const u64 size);
+BEDROCK_INLINE_FUNCTION u64 oct_to_str(char* str, u64 val, const u64 size);
+BEDROCK_INLINE_FUNCTION u64 dec_to_str(char* str, s64 val, const bool is_neg);
+BEDROCK_INLINE_FUNCTION void str_bits(u64 val, const u64 bits, char* str);
 
 /* -------------------------------------------------------------------------------------------------------- */
 // -----------------------
 //  Functions Definitions
 // -----------------------
-BEDROCK_FUNCTION_INLINE u64 hex_to_str(char* str, u64 val, const u64 size) {
+BEDROCK_INLINE_FUNCTION u64 hex_to_str(char* str, u64 val, const u64 size) {
     u64 i = 0;                       
     for (i = 0; i < size * 2; ++i) {
 		str[i] = HEX_TO_CHR_CAP(val & 0x0F);
 		val >>= 4;
     }
-    reverse_str(str);
 	str[i] = '\0';
+    reverse_str(str);
 	return i;
 }
 
-BEDROCK_FUNCTION_INLINE u64 oct_to_str(char* str, u64 val, const u64 size) {
+BEDROCK_INLINE_FUNCTION u64 oct_to_str(char* str, u64 val, const u64 size) {
     u64 i = 0;                 
 	u64 oct_size = (size * 8) / 3;
 	for (i = 0; i < oct_size; ++i) {           
 		str[i] = NUM_TO_CHR(val & 0x07); 
 		val >>= 3;                       
     }                                    
-	reverse_str(str);                    
 	str[i] = '\0';                    
+	reverse_str(str);                    
 	return i;
 }
 
-BEDROCK_FUNCTION_INLINE u64 dec_to_str(char* str, s64 val, const bool is_neg) {
-    if (is_neg) val = val * -1;
+BEDROCK_INLINE_FUNCTION u64 dec_to_str(char* str, s64 val, const bool is_neg) {
+	// The magnitude is taken as unsigned, which also covers the s64 minimum and the u64 values past it
+	u64 uval = is_neg ? -((u64) val) : (u64) val;
 	
 	u64 i = 0;                  
     do {                                 
-        str[i] = NUM_TO_CHR(val % 10);  
-        ++i;                          
-        if (val < 10) break;         
-        val = (val - (val % 10)) / 10; 
-    } while (TRUE);                   
+		str[i++] = NUM_TO_CHR(uval % 10);
+		uval /= 10;
+    } while (uval);                   
     
 	if (is_neg) str[i] = '-', ++i; 
 
-    reverse_str(str);              
   	str[i] = '\0';
+    reverse_str(str);              
 
 	return i;
 }
 
+BEDROCK_INLINE_FUNCTION void str_bits(u64 val, const u64 bits, char* str) {
+	for (u64 i = bits; i > 0; --i, val >>= 1) str[i - 1] = NUM_TO_CHR(val & 0x01);
+	str[bits] = '\0';
+	return;
+}
+
 BEDROCK_FUNCTION int bedrock_snprintf(char* str, const u64 size, const char* format, ...) {
     va_list args;
     va_start(args, format);
@@ -79,7 +85,7 @@ BEDROCK_FUNCTION int bedrock_vsnprintf(char* str, const u64 size, const char* fo
 	// TODO: Missing size checks for out-of-bound accesses
 	for (u64 i = 0; (i <= format_size) && (str_index < size); ++i) {
 		if (starts_with((char*) format + i, "%%")) {
-			str[str_index] = 'h';
+			str[str_index] = '%';
 			str_index++;
 			++i;
 		} else if (starts_with((char*) format + i, "%c")) {
@@ -0,0 +1,286 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define _BEDROCK_PRINTING_UTILS_
+#define _BEDROCK_SPECIAL_TYPE_SUPPORT_
+#define _BEDROCK_CHECK_UNUSED_
+#define _BEDROCK_VA_ARGS_
+#include "bedrock.h"
+
+/* -------------------------------------------------------------------------------------------------------- */
+// Bedrock kernels against their libc counterparts, across sizes and (mis)alignments.
+// Every case is calibrated during warmup to run for at least BENCH_TARGET_NS per repetition,
+// then the median and the minimum over the repetitions are reported.
+// Usage: ./bench_kernels [--json path] [--reps n] [--filter kernel]
+//   The CSV goes to stdout, the JSON (if requested) to path.
+#define BENCH_TARGET_NS    2000000ULL
+#define BENCH_DEFAULT_REPS 11
+#define BENCH_MAX_REPS     101
+#define BENCH_MAX_SIZE     (1ULL << 20)
+#define BENCH_PADDING      64
+
+#if defined(__x86_64__) || defined(__i386__)
+#	define BENCH_CYCLES() __builtin_ia32_rdtsc()
+#else
+#	define BENCH_CYCLES() 0ULL
+#endif // BENCH_CYCLES
+
+// Keeps the compiler from hoisting or discarding the benchmarked expression
+#define BENCH_CLOBBER(val) __asm__ __volatile__("" :: "g"(val) : "memory")
+
+typedef struct BenchResult {
+	const char* kernel;
+	const char* impl;
+	u64 size;
+	u64 align;
+	u64 bytes;
+	double ns_per_op;
+	double min_ns_per_op;
+	double cycles_per_op;
+} BenchResult;
+
+typedef struct BenchCtx {
+	u64 reps;
+	const char* filter;
+	FILE* json;
+	u64 results_cnt;
+} BenchCtx;
+
+static const u64 sizes[] = { 8, 64, 512, 4096, 65536, BENCH_MAX_SIZE };
+static const u64 aligns[] = { 0, 1, 7 };
+static u8* src_buf = NULL;
+static u8* dest_buf = NULL;
+
+static u64 now_ns(void) {
+	struct timespec ts = {0};
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64) ts.tv_sec * 1000000000ULL + (u64) ts.tv_nsec;
+}
+
+static int cmp_double(const void* a, const void* b) {
+	const double x = *(const double*) a;
+	const double y = *(const double*) b;
+	return (x > y) - (x < y);
+}
+
+static void bench_report(BenchCtx* ctx, const BenchResult* res) {
+	const double gb_per_s = res -> bytes ? (double) res -> bytes / res -> ns_per_op : 0.0;
+	printf("%s,%s,%llu,%llu,%.3f,%.3f,%.2f,%.3f\n", res -> kernel, res -> impl, res -> size, res -> align, res -> ns_per_op, res -> min_ns_per_op, res -> cycles_per_op, gb_per_s);
+	fflush(stdout);
+
+	if (ctx -> json == NULL) return;
+	fprintf(ctx -> json, "%s\n  {\"kernel\": \"%s\", \"impl\": \"%s\", \"size\": %llu, \"align\": %llu, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"cycles_per_op\": %.2f, \"gb_per_s\": %.3f}",
+			ctx -> results_cnt ? "," : "", res -> kernel, res -> impl, res -> size, res -> align, res -> ns_per_op, res -> min_ns_per_op, res -> cycles_per_op, gb_per_s);
+	ctx -> results_cnt++;
+
+	return;
+}
+
+// Doubles the iterations until a repetition lasts BENCH_TARGET_NS (which also warms caches and
+// branch predictors up), then times ctx -> reps repetitions and reports the median.
+#define BENCH_RUN(ctx, kernel_name, impl_name, bench_size, bench_align, bench_bytes, ...)   \
+	do {                                                                                    \
+		if ((ctx) -> filter != NULL && strcmp((ctx) -> filter, kernel_name)) break;         \
+		u64 iters = 1;                                                                      \
+		while (TRUE) {                                                                      \
+			const u64 start = now_ns();                                                     \
+			for (u64 iter = 0; iter < iters; ++iter) { __VA_ARGS__; }                       \
+			if (now_ns() - start >= BENCH_TARGET_NS) break;                                 \
+			iters <<= 1;                                                                    \
+		}                                                                                   \
+                                                                                            \
+		double ns[BENCH_MAX_REPS] = {0};                                                    \
+		double cycles[BENCH_MAX_REPS] = {0};                                                \
+		for (u64 rep = 0; rep < (ctx) -> reps; ++rep) {                                     \
+			const u64 start_cycles = BENCH_CYCLES();                                        \
+			const u64 start = now_ns();                                                     \
+			for (u64 iter = 0; iter < iters; ++iter) { __VA_ARGS__; }                       \
+			ns[rep] = (double) (now_ns() - start) / (double) iters;                         \
+			cycles[rep] = (double) (BENCH_CYCLES() - start_cycles) / (double) iters;        \
+		}                                                                                   \
+		qsort(ns, (ctx) -> reps, sizeof(double), cmp_double);                               \
+		qsort(cycles, (ctx) -> reps, sizeof(double), cmp_double);                           \
+                                                                                            \
+		const BenchResult res = {                                                           \
+			.kernel = kernel_name, .impl = impl_name, .size = bench_size,                   \
+			.align = bench_align, .bytes = bench_bytes, .ns_per_op = ns[(ctx) -> reps / 2], \
+			.min_ns_per_op = ns[0], .cycles_per_op = cycles[(ctx) -> reps / 2]              \
+		};                                                                                  \
+		bench_report(ctx, &res);                                                            \
+	} while (0)
+
+/* -------------------------------------------------------------------------------------------------------- */
+// Fills the source with a NUL-terminated string of size printable characters at the given offset
+static char* bench_str(u8* buf, const u64 size, const u64 align) {
+	char* str = (char*) buf + align;
+	for (u64 i = 0; i < size; ++i) str[i] = 'a' + (i % 26);
+	str[size] = '\0';
+	return str;
+}
+
+static void bench_memory(BenchCtx* ctx) {
+	for (u64 s = 0; s < ARR_SIZE(sizes); ++s) {
+		for (u64 a = 0; a < ARR_SIZE(aligns); ++a) {
+			const u64 size = sizes[s];
+			const u64 align = aligns[a];
+			u8* src = src_buf + align;
+			u8* dest = dest_buf + BENCH_PADDING - align;
+
+			BENCH_RUN(ctx, "mem_cpy", "bedrock", size, align, size, BENCH_CLOBBER(mem_cpy(dest, src, size)));
+			BENCH_RUN(ctx, "mem_cpy", "libc", size, align, size, BENCH_CLOBBER(memcpy(dest, src, size)));
+
+			BENCH_RUN(ctx, "mem_set_var", "bedrock", size, align, size, { mem_set(dest, 0x5A, size); BENCH_CLOBBER(dest); });
+			BENCH_RUN(ctx, "mem_set_var", "libc", size, align, size, BENCH_CLOBBER(memset(dest, 0x5A, size)));
+
+			// Overlapping forward move, which rules out the plain copy
+			BENCH_RUN(ctx, "mem_move", "bedrock", size, align, size, BENCH_CLOBBER(mem_move(dest + 1, dest, size)));
+			BENCH_RUN(ctx, "mem_move", "libc", size, align, size, BENCH_CLOBBER(memmove(dest + 1, dest, size)));
+		}
+	}
+
+	return;
+}
+
+static void bench_strings(BenchCtx* ctx) {
+	for (u64 s = 0; s < ARR_SIZE(sizes); ++s) {
+		for (u64 a = 0; a < ARR_SIZE(aligns); ++a) {
+			const u64 size = sizes[s];
+			const u64 align = aligns[a];
+			char* str = bench_str(src_buf, size, align);
+			char* other = bench_str(dest_buf, size, BENCH_PADDING - align);
+
+			BENCH_RUN(ctx, "str_len", "bedrock", size, align, size, BENCH_CLOBBER(str_len(str)));
+			BENCH_RUN(ctx, "str_len", "libc", size, align, size, BENCH_CLOBBER(strlen(str)));
+
+			// Equal strings, so that the whole length is compared
+			BENCH_RUN(ctx, "str_cmp", "bedrock", size, align, 2 * size, BENCH_CLOBBER(str_cmp(str, other)));
+			BENCH_RUN(ctx, "str_cmp", "libc", size, align, 2 * size, BENCH_CLOBBER(strcmp(str, other)));
+
+			// The delimiter only matches at the end of the string
+			const char delim[] = { '#', '#', '\0' };
+			str[size - 2] = '#', str[size - 1] = '#';
+			BENCH_RUN(ctx, "str_tok", "bedrock", size, align, size, BENCH_CLOBBER(str_tok(str, delim)));
+			BENCH_RUN(ctx, "str_tok", "libc", size, align, size, BENCH_CLOBBER(strstr(str, delim)));
+		}
+	}
+
+	return;
+}
+
+static void bench_conversions(BenchCtx* ctx) {
+	// The integer parsers and formatters only take up to 8 bytes, so the size is the digits count
+	const char* const nums[] = { "7", "-4096", "123456789", "-9223372036854775807" };
+	for (u64 n = 0; n < ARR_SIZE(nums); ++n) {
+		for (u64 a = 0; a < ARR_SIZE(aligns); ++a) {
+			const u64 align = aligns[a];
+			const u64 size = str_len(nums[n]);
+			char* str = (char*) src_buf + align;
+			str_cpy(str, nums[n]);
+
+			s64 val = 0;
+			BENCH_RUN(ctx, "str_to_int", "bedrock", size, align, size, { str_to_int(str, '\0', &val); BENCH_CLOBBER(val); });
+			BENCH_RUN(ctx, "str_to_int", "libc", size, align, size, BENCH_CLOBBER(strtoll(str, NULL, 10)));
+
+			const u64 uval = (u64) (val < 0 ? -val : val);
+			char* dest = (char*) dest_buf + BENCH_PADDING - align;
+			BENCH_RUN(ctx, "to_dec_str", "bedrock", size, align, size, BENCH_CLOBBER(to_dec_str(dest, (const u8*) &uval, sizeof(uval))));
+			BENCH_RUN(ctx, "to_dec_str", "libc", size, align, size, BENCH_CLOBBER(snprintf(dest, 24, "%llu", (unsigned long long) uval)));
+		}
+	}
+
+	for (u64 s = 0; s < ARR_SIZE(sizes); ++s) {
+		const u64 size = sizes[s];
+		for (u64 a = 0; a < ARR_SIZE(aligns); ++a) {
+			const u64 align = aligns[a];
+			const u8* src = src_buf + align;
+			char* dest = (char*) dest_buf + align;
+
+			BENCH_RUN(ctx, "to_hex_str", "bedrock", size, align, size, BENCH_CLOBBER(to_hex_str(dest, src, size)));
+			BENCH_RUN(ctx, "to_hex_str", "libc", size, align, size, {
+				for (u64 i = 0; i < size; ++i) snprintf(dest + 2 * i, 3, "%02X", src[i]);
+				BENCH_CLOBBER(dest);
+			});
+		}
+	}
+
+	return;
+}
+
+static int bench_bedrock_snprintf(char* str, const u64 size, const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	const int ret = bedrock_vsnprintf(str, size, format, args);
+	va_end(args);
+	return ret;
+}
+
+static int bench_libc_snprintf(char* str, const u64 size, const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	const int ret = vsnprintf(str, size, format, args);
+	va_end(args);
+	return ret;
+}
+
+static void bench_formatting(BenchCtx* ctx) {
+	const char* const formats[] = { "plain text without any conversion", "%s=%d", "%s: %d %u %lld %llu", "[%s] %d %x %llx %llx" };
+	for (u64 f = 0; f < ARR_SIZE(formats); ++f) {
+		const u64 size = str_len(formats[f]);
+		char* dest = (char*) dest_buf;
+		const char* name = "key";
+		BENCH_RUN(ctx, "bedrock_vsnprintf", "bedrock", size, 0ULL, size,
+				  BENCH_CLOBBER(bench_bedrock_snprintf(dest, 256, formats[f], name, -42, 42U, -1234567890123LL, 1234567890123ULL)));
+		BENCH_RUN(ctx, "bedrock_vsnprintf", "libc", size, 0ULL, size,
+				  BENCH_CLOBBER(bench_libc_snprintf(dest, 256, formats[f], name, -42, 42U, -1234567890123LL, 1234567890123ULL)));
+	}
+
+	return;
+}
+
+int main(int argc, char* argv[]) {
+	BenchCtx ctx = { .reps = BENCH_DEFAULT_REPS };
+	const char* json_path = NULL;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--json") && i + 1 < argc) json_path = argv[++i];
+		else if (!strcmp(argv[i], "--reps") && i + 1 < argc) ctx.reps = strtoull(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc) ctx.filter = argv[++i];
+		else {
+			fprintf(stderr, "Usage: %s [--json path] [--reps n] [--filter kernel]\n", argv[0]);
+			return 1;
+		}
+	}
+	ctx.reps = MIN(MAX(ctx.reps, 1ULL), BENCH_MAX_REPS);
+
+	// Both buffers leave room for a misaligned NUL-terminated string of the largest size
+	src_buf = (u8*) aligned_alloc(BENCH_PADDING, 2 * BENCH_MAX_SIZE + 2 * BENCH_PADDING);
+	dest_buf = (u8*) aligned_alloc(BENCH_PADDING, 2 * BENCH_MAX_SIZE + 2 * BENCH_PADDING);
+	if (src_buf == NULL || dest_buf == NULL) {
+		fprintf(stderr, "Failed to allocate the benchmark buffers.\n");
+		return 1;
+	}
+	for (u64 i = 0; i < 2 * BENCH_MAX_SIZE + 2 * BENCH_PADDING; ++i) src_buf[i] = (u8) (i * 131), dest_buf[i] = 0;
+
+	if (json_path != NULL && (ctx.json = fopen(json_path, "w")) == NULL) {
+		fprintf(stderr, "Failed to open '%s'.\n", json_path);
+		return 1;
+	}
+
+	if (ctx.json != NULL) fprintf(ctx.json, "[");
+	printf("kernel,impl,size,align,ns_per_op,min_ns_per_op,cycles_per_op,gb_per_s\n");
+	bench_memory(&ctx);
+	bench_strings(&ctx);
+	bench_conversions(&ctx);
+	bench_formatting(&ctx);
+	if (ctx.json != NULL) {
+		fprintf(ctx.json, "\n]\n");
+		fclose(ctx.json);
+	}
+
+	free(src_buf);
+	free(dest_buf);
+
+	return 0;
+}
@@ -0,0 +1,279 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#define _BEDROCK_PRINTING_UTILS_
+#define _BEDROCK_SPECIAL_TYPE_SUPPORT_
+#define _BEDROCK_CHECK_UNUSED_
+#define _BEDROCK_QUEUE_
+#include "bedrock.h"
+
+/* -------------------------------------------------------------------------------------------------------- */
+// Throughput and round-trip latency of the SPSC and MPMC queues for a sample of (producer, consumer) core
+// pairs, followed by the MPMC throughput with several producers and consumers.
+// Usage: ./bench_queue [--full] [items] [round_trips]
+// --full sweeps every core pair and every power of two producers/consumers split, instead of the sample.
+#define QUEUE_CAPACITY    4096
+#define BATCH_SIZE        64
+#define SPIN_LIMIT        1024
+#define MPMC_MAX_THREADS  64
+
+BEDROCK_SPSC_QUEUE(SpscQueue, u64)
+BEDROCK_MPMC_QUEUE(MpmcQueue, u64)
+
+typedef enum BenchKind { BENCH_SPSC, BENCH_SPSC_BATCH, BENCH_MPMC } BenchKind;
+
+typedef struct BenchCtx {
+	BenchKind kind;
+	int core;
+	u64 items;
+	SpscQueue* spsc[2];
+	MpmcQueue* mpmc[2];
+} BenchCtx;
+
+typedef struct MpmcCtx {
+	MpmcQueue* queue;
+	int core;
+	u64 first;     // first value pushed by a producer
+	u64 items;     // values pushed by a producer
+	u64 total;     // values pushed by all the producers
+	u64* popped;   // values popped by all the consumers
+	u64 sum;       // sum of the values popped by a consumer
+} MpmcCtx;
+
+static u64 now_ns(void) {
+	struct timespec ts = {0};
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64) ts.tv_sec * 1000000000ULL + (u64) ts.tv_nsec;
+}
+
+static void pin_thread(const int core) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	return;
+}
+
+// NOTE: Yield once in a while, so that the benchmark still makes progress when both threads share a core
+static void backoff(u64* spins) {
+	if (++(*spins) % SPIN_LIMIT) BEDROCK_CPU_RELAX();
+	else sched_yield();
+	return;
+}
+
+static bool bench_push(BenchCtx* ctx, const u8 queue, const u64 val) {
+	if (ctx -> kind == BENCH_MPMC) return MpmcQueue_push(ctx -> mpmc[queue], val);
+	return SpscQueue_push(ctx -> spsc[queue], val);
+}
+
+static bool bench_pop(BenchCtx* ctx, const u8 queue, u64* val) {
+	if (ctx -> kind == BENCH_MPMC) return MpmcQueue_pop(ctx -> mpmc[queue], val);
+	return SpscQueue_pop(ctx -> spsc[queue], val);
+}
+
+static void* producer(void* arg) {
+	BenchCtx* ctx = (BenchCtx*) arg;
+	pin_thread(ctx -> core);
+
+	u64 spins = 0;
+	if (ctx -> kind == BENCH_SPSC_BATCH) {
+		u64 batch[BATCH_SIZE] = {0};
+		for (u64 i = 0; i < ctx -> items;) {
+			const u64 cnt = MIN(BATCH_SIZE, ctx -> items - i);
+			for (u64 j = 0; j < cnt; ++j) batch[j] = i + j;
+			u64 pushed = 0;
+			while ((pushed += SpscQueue_push_batch(ctx -> spsc[0], batch + pushed, cnt - pushed)) < cnt) backoff(&spins);
+			i += cnt;
+		}
+		return NULL;
+	}
+
+	for (u64 i = 0; i < ctx -> items; ++i) {
+		while (!bench_push(ctx, 0, i)) backoff(&spins);
+	}
+
+	return NULL;
+}
+
+static void* echo(void* arg) {
+	BenchCtx* ctx = (BenchCtx*) arg;
+	pin_thread(ctx -> core);
+
+	u64 spins = 0;
+	for (u64 i = 0; i < ctx -> items; ++i) {
+		u64 val = 0;
+		while (!bench_pop(ctx, 0, &val)) backoff(&spins);
+		while (!bench_push(ctx, 1, val)) backoff(&spins);
+	}
+
+	return NULL;
+}
+
+static double bench_throughput(BenchCtx* ctx, const int consumer_core) {
+	pthread_t thread;
+	pthread_create(&thread, NULL, producer, ctx);
+	pin_thread(consumer_core);
+
+	const u64 start = now_ns();
+	u64 spins = 0;
+	u64 expected = 0;
+	if (ctx -> kind == BENCH_SPSC_BATCH) {
+		u64 batch[BATCH_SIZE] = {0};
+		while (expected < ctx -> items) {
+			const u64 cnt = SpscQueue_pop_batch(ctx -> spsc[0], batch, BATCH_SIZE);
+			if (cnt == 0) backoff(&spins);
+			for (u64 j = 0; j < cnt; ++j) BEDROCK_ASSERT(batch[j] == expected++);
+		}
+	} else {
+		for (; expected < ctx -> items; ++expected) {
+			u64 val = 0;
+			while (!bench_pop(ctx, 0, &val)) backoff(&spins);
+			BEDROCK_ASSERT(val == expected);
+		}
+	}
+	const u64 elapsed = now_ns() - start;
+
+	pthread_join(thread, NULL);
+
+	return (double) ctx -> items * 1e3 / (double) elapsed;
+}
+
+static double bench_latency(BenchCtx* ctx, const int main_core) {
+	pthread_t thread;
+	pthread_create(&thread, NULL, echo, ctx);
+	pin_thread(main_core);
+
+	const u64 start = now_ns();
+	u64 spins = 0;
+	for (u64 i = 0; i < ctx -> items; ++i) {
+		u64 val = 0;
+		while (!bench_push(ctx, 0, i)) backoff(&spins);
+		while (!bench_pop(ctx, 1, &val)) backoff(&spins);
+	}
+	const u64 elapsed = now_ns() - start;
+
+	pthread_join(thread, NULL);
+
+	return (double) elapsed / (double) ctx -> items;
+}
+
+static void* mpmc_producer(void* arg) {
+	MpmcCtx* ctx = (MpmcCtx*) arg;
+	pin_thread(ctx -> core);
+
+	u64 spins = 0;
+	for (u64 i = ctx -> first; i < ctx -> first + ctx -> items; ++i) {
+		while (!MpmcQueue_push(ctx -> queue, i)) backoff(&spins);
+	}
+
+	return NULL;
+}
+
+static void* mpmc_consumer(void* arg) {
+	MpmcCtx* ctx = (MpmcCtx*) arg;
+	pin_thread(ctx -> core);
+
+	u64 spins = 0;
+	while (BEDROCK_ATOMIC_LOAD(ctx -> popped, __ATOMIC_RELAXED) < ctx -> total) {
+		u64 val = 0;
+		if (!MpmcQueue_pop(ctx -> queue, &val)) {
+			backoff(&spins);
+			continue;
+		}
+		ctx -> sum += val;
+		__atomic_fetch_add(ctx -> popped, 1, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+// Producers and consumers are pinned round-robin starting from core 0, the producers first
+static double bench_mpmc_threads(MpmcQueue* queue, const int producers, const int consumers, const int cores, const u64 items) {
+	MpmcCtx ctxs[MPMC_MAX_THREADS] = {0};
+	pthread_t threads[MPMC_MAX_THREADS];
+	const u64 per_producer = items / producers;
+	const u64 total = per_producer * producers;
+	u64 popped = 0;
+
+	const u64 start = now_ns();
+	for (int i = 0; i < producers + consumers; ++i) {
+		const bool is_producer = i < producers;
+		ctxs[i] = (MpmcCtx) { .queue = queue, .core = i % cores, .first = i * per_producer, .items = per_producer, .total = total, .popped = &popped };
+		pthread_create(threads + i, NULL, is_producer ? mpmc_producer : mpmc_consumer, ctxs + i);
+	}
+	for (int i = 0; i < producers + consumers; ++i) pthread_join(threads[i], NULL);
+	const u64 elapsed = now_ns() - start;
+
+	u64 sum = 0;
+	for (int i = producers; i < producers + consumers; ++i) sum += ctxs[i].sum;
+	BEDROCK_ASSERT(sum == total * (total - 1) / 2);
+
+	return (double) total * 1e3 / (double) elapsed;
+}
+
+static bool is_sampled_pair(const int producer_core, const int consumer_core, const int cores) {
+	if (cores == 1) return TRUE;
+	return producer_core == 0 && (consumer_core == 1 || consumer_core == cores / 2 || consumer_core == cores - 1);
+}
+
+int main(int argc, char* argv[]) {
+	bool full = FALSE;
+	u64 items = 1000000ULL;
+	u64 round_trips = 100000ULL;
+	for (int i = 1, positional = 0; i < argc; ++i) {
+		if (str_cmp(argv[i], "--full") == 0) full = TRUE;
+		else if (positional++ == 0) items = strtoull(argv[i], NULL, 10);
+		else round_trips = strtoull(argv[i], NULL, 10);
+	}
+	const int cores = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+	// The queues come from _create, so that head and tail sit on their own cache lines
+	SpscQueue* spsc[2] = {0};
+	MpmcQueue* mpmc[2] = {0};
+	for (u8 i = 0; i < 2; ++i) {
+		if ((spsc[i] = SpscQueue_create(QUEUE_CAPACITY)) == NULL || (mpmc[i] = MpmcQueue_create(QUEUE_CAPACITY)) == NULL) return 1;
+	}
+
+	const char* names[] = { "spsc", "spsc_batch", "mpmc" };
+	printf("queue,producers,consumers,producer_core,consumer_core,throughput_mops,round_trip_ns\n");
+	for (int producer_core = 0; producer_core < cores; ++producer_core) {
+		for (int consumer_core = 0; consumer_core < cores; ++consumer_core) {
+			if (producer_core == consumer_core && cores > 1) continue;
+			if (!full && !is_sampled_pair(producer_core, consumer_core, cores)) continue;
+			for (BenchKind kind = BENCH_SPSC; kind <= BENCH_MPMC; ++kind) {
+				BenchCtx ctx = { .kind = kind, .core = producer_core, .items = items, .spsc = { spsc[0], spsc[1] }, .mpmc = { mpmc[0], mpmc[1] } };
+				const double throughput = bench_throughput(&ctx, consumer_core);
+
+				double latency = 0.0;
+				if (kind != BENCH_SPSC_BATCH) {
+					ctx.items = round_trips;
+					latency = bench_latency(&ctx, consumer_core);
+				}
+
+				printf("%s,1,1,%d,%d,%.2f,%.1f\n", names[kind], producer_core, consumer_core, throughput, latency);
+			}
+		}
+	}
+
+	// The sample keeps to balanced splits, as the unbalanced ones mostly measure the idle side spinning
+	for (int producers = 1; producers <= MPMC_MAX_THREADS / 2; producers <<= 1) {
+		for (int consumers = 1; consumers <= MPMC_MAX_THREADS / 2; consumers <<= 1) {
+			if (producers == 1 && consumers == 1) continue;
+			if (full ? (producers + consumers > MAX(2 * cores, 4)) : (producers != consumers || producers > MAX(cores / 2, 2))) continue;
+			const double throughput = bench_mpmc_threads(mpmc[0], producers, consumers, cores, items);
+			printf("mpmc,%d,%d,0,%d,%.2f,%.1f\n", producers, consumers, producers % cores, throughput, 0.0);
+		}
+	}
+
+	for (u8 i = 0; i < 2; ++i) {
+		SpscQueue_destroy(spsc[i]);
+		MpmcQueue_destroy(mpmc[i]);
+	}
+
+	return 0;
+}
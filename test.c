@@ -4,9 +4,643 @@
 #define _BEDROCK_PRINTING_UTILS_
 #define _BEDROCK_SPECIAL_TYPE_SUPPORT_
 #define _BEDROCK_CHECK_UNUSED_
+#define _BEDROCK_TOKENIZER_
+#define _BEDROCK_UTF8_
+#define _BEDROCK_ENDIAN_
+#define _BEDROCK_BITS_
+#define _BEDROCK_QUEUE_
+#define _BEDROCK_THREAD_POOL_
+#define _BEDROCK_SORT_
+#define _BEDROCK_PROFILE_
+#define _BEDROCK_PROFILE_IMPLEMENTATION_
+#define _BEDROCK_DIVIDE_
+#define _BEDROCK_VA_ARGS_
 #include "bedrock.h"
 
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("FAILED: " __FILE__ ":%d: %s\n", __LINE__, #cond); failures++; } } while (0)
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------
+//  Tokenizer
+// -----------
+// Splits str into records and checks that they match the expected fields, records being separated by '|'
+static void check_records_with(BedrockTokenizer tok, const char* str, const char* expected) {
+	const u64 len = str_len(str);
+	u64* indices = bedrock_calloc(TOK_INDEX_CAPACITY(len), sizeof(u64));
+	const u64 indices_cnt = tok_index(&tok, str, len, indices);
+
+	BedrockRecordIter it = {0};
+	tok_record_iter(&it, str, len, indices, indices_cnt);
+
+	char records[512] = {0};
+	u64 pos = 0;
+	BedrockField fields[8] = {0};
+	s64 fields_cnt = 0;
+	while ((fields_cnt = tok_next_record(&tok, &it, fields, 8)) > 0) {
+		if (pos) records[pos++] = '|';
+		for (s64 i = 0; i < fields_cnt; ++i) {
+			records[pos++] = '[';
+			pos += tok_unquote(&tok, records + pos, str, fields[i]);
+			records[pos++] = ']';
+		}
+	}
+
+	CHECK(fields_cnt == 0);
+	if (str_cmp(records, expected)) {
+		printf("FAILED: tokenizing \"%s\" gave \"%s\" instead of \"%s\"\n", str, records, expected);
+		failures++;
+	}
+
+	bedrock_free(indices);
+	return;
+}
+
+static void check_records(const char* str, const char* expected) {
+	BedrockTokenizer tok = {0};
+	tok_init(&tok, ',', '"', '\0', '\0');
+	check_records_with(tok, str, expected);
+	return;
+}
+
+// Pads the fields up to offset 62, so that what follows crosses the first block boundary
+#define TOK_PAD_31 "0123456789012345678901234567890"
+#define TOK_PAD_62 TOK_PAD_31 TOK_PAD_31
+
+static void test_tokenizer(void) {
+	check_records("a,b", "[a][b]");
+	check_records("a,b\n", "[a][b]");
+	check_records("a,b\r\n", "[a][b]");
+	check_records("a,b\nc,d", "[a][b]|[c][d]");
+	check_records("a,b\nc,d\n", "[a][b]|[c][d]");
+	check_records("a,b\r\n\r\nc,\n", "[a][b]|[c][]");
+	check_records("\"a,\"\"b\"\"\",c\n", "[a,\"b\"][c]");
+	check_records("", "");
+	check_records("a\n\"\"\nb\n", "[a]|[]|[b]");
+	check_records(TOK_PAD_62 ",\"a,\nb\",c\n", "[" TOK_PAD_62 "][a,\nb][c]");
+
+	BedrockTokenizer tok = {0};
+	tok_init(&tok, ',', '"', '\\', '\0');
+	check_records_with(tok, TOK_PAD_62 "\\\\\\,b\n", "[" TOK_PAD_62 "\\,b]");
+	check_records_with(tok, TOK_PAD_62 "\\\\\\\\,b\n", "[" TOK_PAD_62 "\\\\][b]");
+	check_records_with(tok, TOK_PAD_62 ",\"\\\",\"\n", "[" TOK_PAD_62 "][\",]");
+
+	tok_init(&tok, ',', '"', '\0', '=');
+	check_records_with(tok, "a=1,b=2\nc=3\n", "[a][1][b][2]|[c][3]");
+
+	tok_init(&tok, ',', '"', '\0', '\0');
+	tok.trim = TRUE;
+	check_records_with(tok, " a , b \r\n\t\"c\" ,d", "[a][b]|[c][d]");
+
+	tok_init(&tok, ',', '"', '\0', '\0');
+	s64 ids[4] = {0};
+	BedrockField names[4] = {0};
+	const BedrockColumn columns[] = {
+		{ .type = BEDROCK_COLUMN_S64, .data = ids },
+		{ .type = BEDROCK_COLUMN_FIELD, .data = names }
+	};
+
+	const char* csv = "1,one\n-22,two\n333,\"three\"";
+	u64 consumed = 0;
+	CHECK(tok_decode(&tok, csv, str_len(csv), columns, 2, 4, &consumed) == 3);
+	CHECK(consumed == str_len(csv));
+	CHECK(ids[0] == 1 && ids[1] == -22 && ids[2] == 333);
+	CHECK(names[2].length == 5 && mem_n_cmp(csv + names[2].offset, "three", 5) == 0);
+
+	// Resume a batch stopped at max_records
+	CHECK(tok_decode(&tok, csv, str_len(csv), columns, 2, 2, &consumed) == 2);
+	CHECK(consumed == 14);
+	CHECK(tok_decode(&tok, csv + consumed, str_len(csv) - consumed, columns, 2, 2, &consumed) == 1);
+	CHECK(ids[0] == 333 && consumed == str_len(csv) - 14);
+
+	const char* trailing = "1,one\n2,two\n";
+	CHECK(tok_decode(&tok, trailing, str_len(trailing), columns, 2, 4, NULL) == 2);
+
+	const char* unterminated = "1,one\n2,\"two\n";
+	CHECK(tok_decode(&tok, unterminated, str_len(unterminated), columns, 2, 4, NULL) == -1);
+
+	const char* missing = "1,one\n2\n";
+	CHECK(tok_decode(&tok, missing, str_len(missing), columns, 2, 4, NULL) == -1);
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -------
+//  UTF-8
+// -------
+// Byte by byte reference validator, following the well-formed byte sequences table of the Unicode standard
+static bool ref_utf8_validate(const u8* str, const u64 len) {
+	for (u64 i = 0; i < len;) {
+		const u8 lead = str[i];
+		u8 size = 0;
+		u8 lo = 0x80, hi = 0xBF;
+		if (lead < 0x80) size = 1;
+		else if (lead >= 0xC2 && lead <= 0xDF) size = 2;
+		else if (lead >= 0xE0 && lead <= 0xEF) size = 3, lo = (lead == 0xE0) ? 0xA0 : 0x80, hi = (lead == 0xED) ? 0x9F : 0xBF;
+		else if (lead >= 0xF0 && lead <= 0xF4) size = 4, lo = (lead == 0xF0) ? 0x90 : 0x80, hi = (lead == 0xF4) ? 0x8F : 0xBF;
+		else return FALSE;
+
+		if (len - i < size) return FALSE;
+		if (size > 1 && (str[i + 1] < lo || str[i + 1] > hi)) return FALSE;
+		for (u8 j = 2; j < size; ++j) {
+			if (!UTF8_IS_CONTINUATION(str[i + j])) return FALSE;
+		}
+		
+		i += size;
+	}
+
+	return TRUE;
+}
+
+static void test_utf8(void) {
+	// Leads and continuations around every boundary of the validation table
+	const u8 pool[] = { 'a', 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF };
+	u8 str[160] = {0};
+	u32 utf32[160] = {0};
+	u16 utf16[160] = {0};
+	char back[640] = {0};
+
+	srand(26);
+	u64 valid_cnt = 0;
+	for (u32 i = 0; i < 50000; ++i) {
+		// Well-formed text of 1 to 4 bytes sequences, with a byte from the pool injected half of the times
+		u64 len = 0;
+		const u64 target = rand() % (sizeof(str) - 4);
+		while (len < target) {
+			const u32 limits[] = { 0x80, 0x800, 0x10000, UTF8_MAX_CODE_POINT + 1 };
+			const u32 code_point = rand() % limits[rand() % 4];
+			if (code_point < 0xD800 || code_point > 0xDFFF) len += utf8_encode(code_point, str + len);
+		}
+		if (len > 0 && (i & 1)) str[rand() % len] = pool[rand() % sizeof(pool)];
+
+		const bool valid = ref_utf8_validate(str, len);
+		CHECK(utf8_validate((char*) str, len) == valid);
+		if (!valid) {
+			CHECK(utf8_to_utf32((char*) str, len, utf32) == -1);
+			continue;
+		}
+
+		valid_cnt++;
+		const s64 utf32_len = utf8_to_utf32((char*) str, len, utf32);
+		CHECK(utf32_len == (s64) utf8_count((char*) str, len));
+		CHECK(utf32_to_utf8(utf32, utf32_len, back) == (s64) len && mem_n_cmp(back, str, len) == 0);
+
+		const s64 utf16_len = utf8_to_utf16((char*) str, len, utf16);
+		CHECK(utf16_len >= utf32_len);
+		CHECK(utf16_to_utf8(utf16, utf16_len, back) == (s64) len && mem_n_cmp(back, str, len) == 0);
+	}
+	CHECK(valid_cnt > 0);
+
+	// Every scalar value survives the round-trip through both encodings
+	for (u32 code_point = 0; code_point <= UTF8_MAX_CODE_POINT; code_point += 7) {
+		const bool is_surrogate = code_point >= 0xD800 && code_point <= 0xDFFF;
+		u8 encoded[4] = {0};
+		u32 decoded = 0;
+		const u8 size = utf8_encode(code_point, encoded);
+		CHECK(is_surrogate ? size == 0 : (size > 0 && utf8_decode(encoded, size, &decoded) == size && decoded == code_point));
+	}
+
+	const u16 unpaired[] = { 'a', 0xD800, 'b' };
+	CHECK(utf16_to_utf8(unpaired, 3, back) == -1);
+
+	char reversed[] = "h\xC3\xA9\xF0\x9D\x84\x9E!";
+	CHECK(str_cmp(utf8_reverse_str(reversed), "!\xF0\x9D\x84\x9E\xC3\xA9h") == 0);
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ------------
+//  Endianness
+// ------------
+static void test_endian(void) {
+	const u8 bytes[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+	// Unaligned loads, byte order being fixed by the encoding rather than by the host
+	CHECK(load_le16(bytes + 1) == 0x0201);
+	CHECK(load_be16(bytes + 1) == 0x0102);
+	CHECK(load_le32(bytes + 1) == 0x04030201);
+	CHECK(load_be32(bytes + 1) == 0x01020304);
+	CHECK(load_le64(bytes + 1) == 0x0807060504030201ULL);
+	CHECK(load_be64(bytes + 1) == 0x0102030405060708ULL);
+
+	u8 out[9] = {0};
+	store_le32(out + 1, 0x04030201);
+	store_be32(out + 5, 0x05060708);
+	CHECK(mem_n_cmp(out + 1, bytes + 1, 8) == 0);
+	store_be64(out + 1, 0x0102030405060708ULL);
+	CHECK(mem_n_cmp(out + 1, bytes + 1, 8) == 0);
+	store_le16(out, 0x0100);
+	store_be16(out + 2, 0x0203);
+	CHECK(mem_n_cmp(out, bytes, 4) == 0);
+
+	u32 val = 0x01020304;
+	be_to_le(&val, sizeof(val));
+	CHECK(val == HOST_TO_BE32(0x01020304));
+	CHECK(LE64_TO_HOST(HOST_TO_LE64(0x0102030405060708ULL)) == 0x0102030405060708ULL);
+
+	// Bulk conversions, with counts that leave a scalar tail after the vectorized blocks
+	u16 src16[37] = {0}, dst16[37] = {0};
+	u32 src32[37] = {0}, dst32[37] = {0};
+	u64 src64[37] = {0}, dst64[37] = {0};
+	for (u64 i = 0; i < 37; ++i) {
+		src16[i] = (u16) (i * 0x0101 + 1);
+		src32[i] = (u32) (i * 0x01010101 + 2);
+		src64[i] = i * 0x0101010101010101ULL + 3;
+	}
+
+	bswap16_arr(dst16, src16, 37);
+	bswap32_arr(dst32, src32, 37);
+	bswap64_arr(dst64, src64, 37);
+	for (u64 i = 0; i < 37; ++i) {
+		CHECK(dst16[i] == __builtin_bswap16(src16[i]));
+		CHECK(dst32[i] == __builtin_bswap32(src32[i]));
+		CHECK(dst64[i] == __builtin_bswap64(src64[i]));
+	}
+
+	// In place
+	bswap32_arr(dst32, dst32, 37);
+	CHECK(mem_n_cmp(dst32, src32, sizeof(src32)) == 0);
+
+	load_be64_arr(dst64, src64, 37);
+	for (u64 i = 0; i < 37; ++i) CHECK(dst64[i] == load_be64(src64 + i));
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ------
+//  Bits
+// ------
+static void test_bits(void) {
+	srand(29);
+	for (u32 i = 0; i < 10000; ++i) {
+		const u64 val = (((u64) rand() << 42) ^ ((u64) rand() << 21) ^ (u64) rand()) >> (rand() % 64);
+
+		u8 leading = 0, trailing = 0, ones = 0;
+		u64 reversed = 0;
+		while (leading < 64 && !GET_BIT(val, 63 - leading)) leading++;
+		while (trailing < 64 && !GET_BIT(val, trailing)) trailing++;
+		for (u8 j = 0; j < 64; ++j) ones += GET_BIT(val, j), reversed |= (u64) GET_BIT(val, j) << (63 - j);
+
+		CHECK(clz64(val) == leading && ctz64(val) == trailing && popcount64(val) == ones);
+		CHECK(bit_reverse64(val) == reversed);
+
+		const u8 shift = rand() % 64;
+		CHECK(rotr64(rotl64(val, shift), shift) == val);
+	}
+
+	CHECK(clz8(1) == 7 && clz16(1) == 15 && clz32(0) == 32 && ctz8(0) == 8 && ctz32(0x80000000U) == 31);
+	CHECK(bit_reverse8(1) == 0x80 && rotl8(0x81, 1) == 0x03);
+
+	BedrockBitset multiples_of_3 = {0}, multiples_of_5 = {0};
+	CHECK(bitset_init(&multiples_of_3, 1000) == 0 && bitset_init(&multiples_of_5, 1000) == 0);
+	for (u64 i = 0; i < 1000; i += 3) bitset_set(&multiples_of_3, i);
+	for (u64 i = 0; i < 1000; i += 5) bitset_set(&multiples_of_5, i);
+	CHECK(bitset_and(&multiples_of_3, &multiples_of_5) == 0);
+	CHECK(bitset_popcount(&multiples_of_3) == 67);
+	BITSET_FOR_EACH(&multiples_of_3, index) CHECK(index % 15 == 0);
+	bitset_deinit(&multiples_of_3);
+	bitset_deinit(&multiples_of_5);
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// --------
+//  Queues
+// --------
+BEDROCK_SPSC_QUEUE(TestSpscQueue, u64)
+BEDROCK_MPMC_QUEUE(TestMpmcQueue, u64)
+
+static void test_queues(void) {
+	u64 val = 0;
+	u64 batch[8] = {0};
+
+	TestSpscQueue spsc = {0};
+	CHECK(TestSpscQueue_init(&spsc, 5) == 0);
+	CHECK(!TestSpscQueue_pop(&spsc, &val));
+	for (u64 i = 0; i < 8; ++i) CHECK(TestSpscQueue_push(&spsc, i));
+	CHECK(!TestSpscQueue_push(&spsc, 8));
+	for (u64 i = 0; i < 3; ++i) CHECK(TestSpscQueue_pop(&spsc, &val) && val == i);
+
+	// The batch wraps around the end of the ring
+	const u64 values[] = { 8, 9, 10, 11 };
+	CHECK(TestSpscQueue_push_batch(&spsc, values, 4) == 3);
+	CHECK(TestSpscQueue_pop_batch(&spsc, batch, 8) == 8);
+	for (u64 i = 0; i < 8; ++i) CHECK(batch[i] == i + 3);
+	CHECK(TestSpscQueue_pop_batch(&spsc, batch, 8) == 0);
+	TestSpscQueue_deinit(&spsc);
+
+	TestMpmcQueue mpmc = {0};
+	CHECK(TestMpmcQueue_init(&mpmc, 4) == 0);
+	for (u64 round = 0; round < 3; ++round) {
+		for (u64 i = 0; i < 4; ++i) CHECK(TestMpmcQueue_push(&mpmc, round * 4 + i));
+		CHECK(!TestMpmcQueue_push(&mpmc, 0));
+		for (u64 i = 0; i < 4; ++i) CHECK(TestMpmcQueue_pop(&mpmc, &val) && val == round * 4 + i);
+		CHECK(!TestMpmcQueue_pop(&mpmc, &val));
+	}
+	TestMpmcQueue_deinit(&mpmc);
+
+	// Heap queues keep their positions on separate cache lines
+	TestMpmcQueue* heap_mpmc = TestMpmcQueue_create(16);
+	CHECK(heap_mpmc != NULL && (__UINTPTR_TYPE__) &(heap_mpmc -> dequeue_pos) % BEDROCK_CACHE_LINE == 0);
+	CHECK(TestMpmcQueue_push(heap_mpmc, 42) && TestMpmcQueue_pop(heap_mpmc, &val) && val == 42);
+	TestMpmcQueue_destroy(heap_mpmc);
+
+	TestSpscQueue* heap_spsc = TestSpscQueue_create(16);
+	CHECK(heap_spsc != NULL && (__UINTPTR_TYPE__) &(heap_spsc -> tail) % BEDROCK_CACHE_LINE == 0);
+	TestSpscQueue_destroy(heap_spsc);
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -------------
+//  Thread Pool
+// -------------
+static void sum_range(void* arg, const u64 start, const u64 end) {
+	u64 sum = 0;
+	for (u64 i = start; i < end; ++i) sum += i;
+	__atomic_add_fetch(CAST_PTR(arg, u64), sum, __ATOMIC_RELAXED);
+	return;
+}
+
+static void test_thread_pool(void) {
+	BedrockThreadPool pool = {0};
+	CHECK(thread_pool_init(&pool, 4) == 0);
+
+	const u64 ranges[][3] = { { 0, 1, 0 }, { 0, 1000, 1 }, { 17, 100000, 0 }, { 5, 1000003, 4096 } };
+	for (u64 i = 0; i < ARR_SIZE(ranges); ++i) {
+		const u64 start = ranges[i][0], end = ranges[i][1];
+		u64 sum = 0;
+		parallel_for(&pool, start, end, ranges[i][2], sum_range, &sum);
+		CHECK(sum == (end * (end - 1) - start * (start - 1)) / 2);
+	}
+
+	// Submissions from the main thread go through the injector
+	u64 sum = 0;
+	BedrockWaitGroup wait_group = {0};
+	for (u64 i = 0; i < 100; ++i) thread_pool_submit_range(&pool, sum_range, &sum, i * 10, (i + 1) * 10, &wait_group);
+	thread_pool_wait(&pool, &wait_group);
+	CHECK(sum == 999 * 1000 / 2);
+
+	const u64 size = 300007;
+	char* src = bedrock_calloc(size, sizeof(char));
+	char* dest = bedrock_calloc(size, sizeof(char));
+	for (u64 i = 0; i < size; ++i) src[i] = (i % 7) ? 'a' + (i % 26) : ',';
+	parallel_mem_cpy(&pool, dest, src, size);
+	CHECK(mem_n_cmp(dest, src, size) == 0);
+	CHECK(parallel_ref_chr_cnt(&pool, src, size, ',') == __ceil(size, 7));
+	bedrock_free(src);
+	bedrock_free(dest);
+
+	// A pattern wider than a parallel block used to give a zero block size
+	int pattern = 0;
+	const int value = 0x01020304;
+	parallel_mem_set_var(&pool, &pattern, value, sizeof(pattern), PARALLEL_BLOCK_SIZE + 1);
+	CHECK(pattern == value);
+
+	thread_pool_deinit(&pool);
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ---------
+//  Sorting
+// ---------
+BEDROCK_SORT_DEFINE(sort_s32, int, BEDROCK_SORT_LESS)
+
+static int cmp_s32(const void* a, const void* b) {
+	return (*(const int*) a > *(const int*) b) - (*(const int*) a < *(const int*) b);
+}
+
+static int cmp_u32(const void* a, const void* b) {
+	return (*(const u32*) a > *(const u32*) b) - (*(const u32*) a < *(const u32*) b);
+}
+
+static int cmp_s64(const void* a, const void* b) {
+	return (*(const s64*) a > *(const s64*) b) - (*(const s64*) a < *(const s64*) b);
+}
+
+// NOTE: str_cmp compares plain chars, which are signed on x86, while str_sort orders the unsigned bytes like strcmp
+static int cmp_str(const void* a, const void* b) {
+	const u8* str1 = *(u8* const*) a;
+	const u8* str2 = *(u8* const*) b;
+	while (*str1 && *str1 == *str2) ++str1, ++str2;
+	return (int) *str1 - (int) *str2;
+}
+
+static u64 rand_u64(void) {
+	return ((u64) rand() << 42) ^ ((u64) rand() << 21) ^ (u64) rand();
+}
+
+static void test_sort(void) {
+	// Lengths on both sides of the insertion and radix thresholds, over random, narrow and presorted inputs
+	const u64 lens[] = { 0, 1, 2, 23, 24, 25, 63, 64, 65, 129, 1000, 20000 };
+	const u64 max_len = 20000;
+	int* ints = bedrock_calloc(max_len, sizeof(int));
+	int* ints_ref = bedrock_calloc(max_len, sizeof(int));
+	u32* keys = bedrock_calloc(max_len, sizeof(u32));
+	u32* keys_ref = bedrock_calloc(max_len, sizeof(u32));
+	u32* payloads = bedrock_calloc(max_len, sizeof(u32));
+	s64* signed_keys = bedrock_calloc(max_len, sizeof(s64));
+	s64* signed_ref = bedrock_calloc(max_len, sizeof(s64));
+
+	srand(32);
+	for (u64 i = 0; i < ARR_SIZE(lens); ++i) {
+		const u64 len = lens[i];
+		for (u8 pattern = 0; pattern < 4; ++pattern) {
+			for (u64 j = 0; j < len; ++j) {
+				const u64 val = rand_u64();
+				switch (pattern) {
+					case 0: ints[j] = (int) val, keys[j] = (u32) val, signed_keys[j] = (s64) val; break;
+					case 1: ints[j] = (int) (val % 8) - 4, keys[j] = (u32) (val % 8), signed_keys[j] = (s64) (val % 8) - 4; break;
+					case 2: ints[j] = (int) j, keys[j] = (u32) j, signed_keys[j] = (s64) j - (s64) (len / 2); break;
+					case 3: ints[j] = (int) (len - j), keys[j] = (u32) (len - j), signed_keys[j] = (s64) (len - j) * -1000; break;
+				}
+				payloads[j] = (u32) j;
+			}
+
+			mem_cpy(ints_ref, ints, len * sizeof(int));
+			mem_cpy(keys_ref, keys, len * sizeof(u32));
+			mem_cpy(signed_ref, signed_keys, len * sizeof(s64));
+			if (len) {
+				qsort(ints_ref, len, sizeof(int), cmp_s32);
+				qsort(signed_ref, len, sizeof(s64), cmp_s64);
+			}
+
+			sort_s32(ints, len);
+			CHECK(len == 0 || mem_n_cmp(ints, ints_ref, len * sizeof(int)) == 0);
+
+			radix_sort_s64(signed_keys, len);
+			CHECK(len == 0 || mem_n_cmp(signed_keys, signed_ref, len * sizeof(s64)) == 0);
+
+			// The payloads follow their keys, and equal keys keep their original order
+			CHECK(radix_sort_u32_kv(keys, payloads, len) == 0);
+			for (u64 j = 0; j < len; ++j) {
+				CHECK(keys[j] == keys_ref[payloads[j]]);
+				if (j > 0) CHECK(keys[j - 1] < keys[j] || (keys[j - 1] == keys[j] && payloads[j - 1] < payloads[j]));
+			}
+			if (len) qsort(keys_ref, len, sizeof(u32), cmp_u32);
+			CHECK(len == 0 || mem_n_cmp(keys, keys_ref, len * sizeof(u32)) == 0);
+		}
+	}
+
+	bedrock_free(ints);
+	bedrock_free(ints_ref);
+	bedrock_free(keys);
+	bedrock_free(keys_ref);
+	bedrock_free(payloads);
+	bedrock_free(signed_keys);
+	bedrock_free(signed_ref);
+
+	// Shared prefixes, empty strings and bytes above 0x7F
+	char words[500][8] = {0};
+	char* strs[500] = {0};
+	char* strs_ref[500] = {0};
+	const char alphabet[] = "ab\xE9";
+	for (u64 i = 0; i < 500; ++i) {
+		const u64 len = rand() % 7;
+		for (u64 j = 0; j < len; ++j) words[i][j] = alphabet[rand() % 3];
+		strs[i] = strs_ref[i] = words[i];
+	}
+	str_sort(strs, 500);
+	qsort(strs_ref, 500, sizeof(char*), cmp_str);
+	for (u64 i = 0; i < 500; ++i) CHECK(str_cmp(strs[i], strs_ref[i]) == 0);
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// -----------
+//  Profiling
+// -----------
+static u64 profile_zone_count(const char* name) {
+	BedrockProfileSnapshot* snapshot = bedrock_calloc(1, sizeof(BedrockProfileSnapshot));
+	profile_snapshot(snapshot);
+	u64 count = 0;
+	for (u32 i = 0; i < snapshot -> zones_cnt; ++i) {
+		if (snapshot -> zones[i].name != NULL && str_cmp(snapshot -> zones[i].name, name) == 0) count += snapshot -> zones[i].stats.count;
+	}
+	bedrock_free(snapshot);
+	return count;
+}
+
+static void record_zone(void* arg, const u64 start, const u64 end) {
+	UNUSED_VAR(arg);
+	for (u64 i = start; i < end; ++i) {
+		PROFILE_ZONE_BEGIN(worker_zone);
+		PROFILE_ZONE_END(worker_zone);
+	}
+	return;
+}
+
+static void test_profile(void) {
+	u64 sum = 0;
+	for (u64 i = 0; i < 10; ++i) {
+		PROFILE_ZONE_BEGIN(main_zone);
+		sum += i;
+		PROFILE_ZONE_END(main_zone);
+		PROFILE_COUNTER_INC(main_counter);
+	}
+	CHECK(sum == 45 && profile_zone_count("main_zone") == 10);
+
+	// Both calls on the same line get their own zone
+	TRACK_CALL(sum++); TRACK_CALL(sum++);
+	CHECK(profile_zone_count("sum++") == 2);
+
+	BedrockThreadPool pool = {0};
+	CHECK(thread_pool_init(&pool, 2) == 0);
+	parallel_for(&pool, 0, 1000, 10, record_zone, NULL);
+	CHECK(profile_zone_count("worker_zone") == 1000);
+
+	// The workers outlive the deinit, and register a new block on their next zone
+	profile_deinit();
+	CHECK(profile_zone_count("worker_zone") == 0);
+	parallel_for(&pool, 0, 1000, 10, record_zone, NULL);
+	CHECK(profile_zone_count("worker_zone") == 1000);
+	thread_pool_deinit(&pool);
+
+	profile_deinit();
+
+	return;
+}
+
+/* -------------------------------------------------------------------------------------------------------- */
+// ----------
+//  Division
+// ----------
+static void test_divide(void) {
+	// Small, power of two, near power of two and full width divisors
+	srand(35);
+	for (u32 i = 0; i < 2000; ++i) {
+		u64 divisor = 0;
+		switch (i % 4) {
+			case 0: divisor = 1 + rand() % 1000; break;
+			case 1: divisor = 1ULL << (rand() % 64); break;
+			case 2: divisor = (1ULL << (1 + rand() % 63)) + (rand() % 3) - 1; break;
+			case 3: divisor = rand_u64() >> (rand() % 64); break;
+		}
+		if (divisor == 0) divisor = 1;
+
+		BedrockDividerU64 div64 = {0};
+		CHECK(divider_u64_init(&div64, divisor) == 0);
+		BedrockDividerU32 div32 = {0};
+		const u32 divisor32 = (u32) divisor ? (u32) divisor : 1;
+		CHECK(divider_u32_init(&div32, divisor32) == 0);
+
+		const u64 edge_vals[] = { 0, 1, divisor - 1, divisor, divisor + 1, ~0ULL, ~0ULL - divisor, (u64) divisor * 3 };
+		for (u32 j = 0; j < ARR_SIZE(edge_vals) + 50; ++j) {
+			const u64 val = (j < ARR_SIZE(edge_vals)) ? edge_vals[j] : rand_u64();
+			u64 rem = 0;
+			CHECK(divider_u64_divmod(&div64, val, &rem) == val / divisor && rem == val % divisor);
+			CHECK(divider_u64_ceil_div(&div64, val) == val / divisor + (val % divisor != 0));
+
+			const u32 val32 = (u32) val;
+			u32 rem32 = 0;
+			CHECK(divider_u32_divmod(&div32, val32, &rem32) == val32 / divisor32 && rem32 == val32 % divisor32);
+			CHECK(divider_u32_ceil_div(&div32, val32) == val32 / divisor32 + (val32 % divisor32 != 0));
+		}
+	}
+
+	BedrockDividerU64 div64 = {0};
+	CHECK(divider_u64_init(&div64, 0) == -1);
+
+	BedrockPow2Divider pow2 = {0};
+	CHECK(pow2_divider_init(&pow2, 12) == -1);
+	CHECK(pow2_divider_init(&pow2, 16) == 0);
+	CHECK(pow2_divider_div(&pow2, 100) == 6 && pow2_divider_mod(&pow2, 100) == 4 && pow2_divider_ceil_div(&pow2, 100) == 7);
+
+	// The decimal formatting paths
+	char str[256] = {0};
+	const u64 val = 18446744073709551615ULL;
+	CHECK(str_cmp(to_dec_str(str, (const u8*) &val, sizeof(val)), "18446744073709551615") == 0);
+	const u8 zero = 0;
+	CHECK(str_cmp(to_dec_str(str, &zero, sizeof(zero)), "0") == 0);
+	bedrock_snprintf(str, sizeof(str), "%d %lld %llu %u", -42, (long long int) (-9223372036854775807LL - 1), val, 0);
+	CHECK(str_cmp(str, "-42 -9223372036854775808 18446744073709551615 0") == 0);
+
+	return;
+}
+
 int main(void) {
-	return 0;
+	test_tokenizer();
+	test_utf8();
+	test_endian();
+	test_bits();
+	test_queues();
+	test_thread_pool();
+	test_sort();
+	test_profile();
+	test_divide();
+
+	if (failures) printf("%d checks failed.\n", failures);
+	else printf("All checks passed.\n");
+
+	return failures != 0;
 }
 